@@ -0,0 +1,16 @@
+/**
+ Filename:       JMERemoterRes.c
+ Revised:        $Date: 2015-06-18$
+ Revision:       $Revision: 01 $
+
+ Description:    Host build stand-in for the firmware resources. The font
+                 cells are blank: text drawn on the host has the size, the
+                 windows and the bus cost of the real font, in the background
+                 color only. Link the firmware's table instead to see glyphs.
+
+ Copyright 2015 ObornJung. All rights reserved.
+ */
+
+#include "JMERemoterRes.h"
+
+const uint8_t kJME_ASCII8x12_Table[95 * 12] = {0};
@@ -0,0 +1,22 @@
+/**
+ Filename:       JMERemoterRes.h
+ Revised:        $Date: 2015-06-18$
+ Revision:       $Revision: 01 $
+
+ Description:    Host build stand-in for the firmware resource header. Only
+                 the built-in font of JMEST7735R_drawString is declared.
+
+ Copyright 2015 ObornJung. All rights reserved.
+ */
+
+#ifndef __H__JMERemoterRes__H__
+#define __H__JMERemoterRes__H__
+
+#include "JMEBase.h"
+
+//
+// 8x12 glyphs of the printable ASCII characters from ' ', 12 rows each,
+// leftmost pixel in bit 7
+JME_EXTERN const uint8_t kJME_ASCII8x12_Table[];
+
+#endif /* defined(__H__JMERemoterRes__H__) */
@@ -0,0 +1,12 @@
+/**
+ Filename:       JMEST7735R_DriveLib.h
+ Revised:        $Date: 2015-06-18$
+ Revision:       $Revision: 01 $
+
+ Description:    Host build alias. The driver sources include the driver
+                 header under its firmware project name.
+
+ Copyright 2015 ObornJung. All rights reserved.
+ */
+
+#include "OBST7735R_DriveLib.h"
@@ -0,0 +1,87 @@
+/**
+ Filename:       JMEDamageRegion.c
+ Revised:        $Date: 2015-06-18$
+ Revision:       $Revision: 01 $
+ Author:         Oborn.Jung
+
+ Description:    This file contains the damage region tracker. It collects
+                 invalidated rectangles and merges them into a short list of
+                 flush rectangles.
+
+ Copyright 2015 JONMA Inc. All rights reserved.
+ */
+
+#include "JMEDamageRegion.h"
+
+static uint32_t _JMEDamageRegionArea(JMERect rect)
+{
+    return (uint32_t)rect.size.width * rect.size.height;
+}
+
+/**
+ *  Pixels saved (positive) or wasted (negative) by flushing `r1' and `r2'
+ *  as their union instead of as two windows.
+ */
+static int32_t _JMEDamageRegionMergeGain(const JMEDamageRegion * region, JMERect r1, JMERect r2)
+{
+    int32_t separate = (int32_t)(_JMEDamageRegionArea(r1) + _JMEDamageRegionArea(r2) + region->setupCost);
+    return separate - (int32_t)_JMEDamageRegionArea(JMERectUnion(r1, r2));
+}
+
+static void _JMEDamageRegionRemove(JMEDamageRegion * region, uint8_t index)
+{
+    region->rects[index] = region->rects[-- region->count];
+}
+
+void JMEDamageRegionInit(JMEDamageRegion * region, uint16_t setupCost)
+{
+    region->count = 0;
+    region->setupCost = setupCost;
+}
+
+void JMEDamageRegionClear(JMEDamageRegion * region)
+{
+    region->count = 0;
+}
+
+void JMEDamageRegionAdd(JMEDamageRegion * region, JMERect rect)
+{
+    BOOL isMerged;
+    if (JMERectIsEmpty(rect)) {
+        return;
+    }
+    do {
+        int32_t bestGain = -0x7FFFFFFF;
+        uint8_t bestIndex = 0;
+        isMerged = FALSE;
+        for (uint8_t i = 0; i < region->count; i ++) {
+            int32_t gain = _JMEDamageRegionMergeGain(region, region->rects[i], rect);
+            if (gain > bestGain) {
+                bestGain = gain;
+                bestIndex = i;
+            }
+        }
+        //
+        // absorb the best partner while that pays off, or when there is no
+        // room left for another rectangle
+        if (region->count > 0 && (bestGain >= 0 || region->count >= JMEDAMAGEREGION_MAX_RECTS)) {
+            rect = JMERectUnion(region->rects[bestIndex], rect);
+            _JMEDamageRegionRemove(region, bestIndex);
+            isMerged = TRUE;
+        }
+    } while (isMerged);
+    region->rects[region->count ++] = rect;
+}
+
+BOOL JMEDamageRegionIsEmpty(const JMEDamageRegion * region)
+{
+    return 0 == region->count;
+}
+
+uint8_t JMEDamageRegionGetRects(const JMEDamageRegion * region, const JMERect ** rects)
+{
+    if (NULL != rects) {
+        *rects = region->rects;
+    }
+    return region->count;
+}
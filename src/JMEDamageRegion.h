@@ -0,0 +1,58 @@
+/**
+ Filename:       JMEDamageRegion.h
+ Revised:        $Date: 2015-06-18$
+ Revision:       $Revision: 01 $
+ Author:         Oborn.Jung
+
+ Description:    This file contains the damage region tracker. It collects
+                 invalidated rectangles and merges them into a short list of
+                 flush rectangles.
+
+ Copyright 2015 JONMA Inc. All rights reserved.
+ */
+#ifndef __H__JMEDamageRegion__H__
+#define __H__JMEDamageRegion__H__
+
+#include "JMEBase.h"
+#include "JMEGeometry.h"
+
+#define JMEDAMAGEREGION_MAX_RECTS       8
+
+/**
+ *  Damage region. `setupCost' is the price of one more flush rectangle,
+ *  expressed in pixels: two rectangles are merged when their union costs no
+ *  more pixels than flushing both plus one extra window setup.
+ */
+typedef struct JMEDamageRegion {
+    uint8_t             count;
+    uint16_t            setupCost;
+    JMERect             rects[JMEDAMAGEREGION_MAX_RECTS];
+} JMEDamageRegion;
+
+/**
+ *  Reset `region' to empty, with window setup costing `setupCost' pixels.
+ */
+JME_EXTERN void JMEDamageRegionInit(JMEDamageRegion * region, uint16_t setupCost);
+
+/**
+ *  Forget all damage collected in `region'.
+ */
+JME_EXTERN void JMEDamageRegionClear(JMEDamageRegion * region);
+
+/**
+ *  Add `rect' to `region', merging it with the rectangles it is cheaper to
+ *  flush together with. When the list is full the cheapest merge is forced.
+ */
+JME_EXTERN void JMEDamageRegionAdd(JMEDamageRegion * region, JMERect rect);
+
+/**
+ *  Return true if nothing has been invalidated in `region'.
+ */
+JME_EXTERN BOOL JMEDamageRegionIsEmpty(const JMEDamageRegion * region);
+
+/**
+ *  Return the number of flush rectangles and point `rects' at them.
+ */
+JME_EXTERN uint8_t JMEDamageRegionGetRects(const JMEDamageRegion * region, const JMERect ** rects);
+
+#endif /* defined(__H__JMEDamageRegion__H__) */
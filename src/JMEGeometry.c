@@ -32,3 +32,22 @@ const JMERect JMERectZero = {{0, 0}, {0, 0}};
  *  same as the zero rect.
  */
 const JMERect JMERectNull = {{0, 0}, {0, 0}};
+
+uint16_t JMERectIntersectRects(JMERect rect, const JMERect * rects, uint16_t count,
+                               JMERect * intersections)
+{
+    JMEGeometryWide maxX = JMERectGetMaxX(rect);
+    JMEGeometryWide maxY = JMERectGetMaxY(rect);
+    uint16_t hits = 0;
+    for (uint16_t i = 0; i < count; i ++) {
+        JMERect hit = JMERectMakeEdges(JMEMax(rect.origin.x, rects[i].origin.x),
+                                       JMEMax(rect.origin.y, rects[i].origin.y),
+                                       JMEMin(maxX, JMERectGetMaxX(rects[i])),
+                                       JMEMin(maxY, JMERectGetMaxY(rects[i])));
+        hits += !JMERectIsEmpty(hit);
+        if (NULL != intersections) {
+            intersections[i] = hit;
+        }
+    }
+    return hits;
+}
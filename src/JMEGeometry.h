@@ -17,6 +17,13 @@
 typedef uint8_t JMEGeometryUnit;
 #define JMEGeometryUnitEqual(a, b)       ((a) == (b))
 
+/**
+ *  Edges and sums of units, which reach past the end of JMEGeometryUnit:
+ *  a rect at x 200 that is 100 wide ends at 300.
+ */
+typedef int16_t JMEGeometryWide;
+#define JMEGeometryUnitMax              ((JMEGeometryWide)(JMEGeometryUnit)~0)
+
 /**
  *  Points.
  */
@@ -84,28 +91,28 @@ JME_EXTERN const JMERect JMERectNull;
 /**
  *  Make a point from `(x, y)'.
  */
-inline JMEPoint JMEPointMake(JMEGeometryUnit x, JMEGeometryUnit y) {
+static inline JMEPoint JMEPointMake(JMEGeometryUnit x, JMEGeometryUnit y) {
     JMEPoint p; p.x = x; p.y = y; return p;
 }
 
 /**
  *  Make a size from `(width, height)'.
  */
-inline JMESize JMESizeMake(JMEGeometryUnit width, JMEGeometryUnit height) {
+static inline JMESize JMESizeMake(JMEGeometryUnit width, JMEGeometryUnit height) {
     JMESize size; size.width = width; size.height = height; return size;
 }
 
 /**
  *  Make a vector from `(dx, dy)'.
  */
-inline JMEVector JMEVectorMake(JMEGeometryUnit dx, JMEGeometryUnit dy) {
+static inline JMEVector JMEVectorMake(JMEGeometryUnit dx, JMEGeometryUnit dy) {
     JMEVector vector; vector.dx = dx; vector.dy = dy; return vector;
 }
 
 /**
  *  Make a rect from `(x, y; width, height)'.
  */
-inline JMERect JMERectMake(JMEGeometryUnit x, JMEGeometryUnit y, JMEGeometryUnit width, JMEGeometryUnit height) {
+static inline JMERect JMERectMake(JMEGeometryUnit x, JMEGeometryUnit y, JMEGeometryUnit width, JMEGeometryUnit height) {
     JMERect rect;
     rect.origin.x = x;
     rect.origin.y = y;
@@ -117,66 +124,66 @@ inline JMERect JMERectMake(JMEGeometryUnit x, JMEGeometryUnit y, JMEGeometryUnit
 /**
  *  Return the leftmost x-value of `rect'.
  */
-inline JMEGeometryUnit JMERectGetMinX(JMERect rect) {
-    return JMEMin(rect.origin.x, rect.origin.x + rect.size.width);
+static inline JMEGeometryUnit JMERectGetMinX(JMERect rect) {
+    return rect.origin.x;
 }
 
 /**
  *  Return the midpoint x-value of `rect'.
  */
-inline JMEGeometryUnit JMERectGetMidX(JMERect rect) {
-    return rect.origin.x + rect.size.width / 2;
+static inline JMEGeometryWide JMERectGetMidX(JMERect rect) {
+    return (JMEGeometryWide)rect.origin.x + rect.size.width / 2;
 }
 
 /**
- *  Return the rightmost x-value of `rect'.
+ *  Return the rightmost x-value of `rect', one past its last column.
  */
-inline JMEGeometryUnit JMERectGetMaxX(JMERect rect) {
-    return JMEMax(rect.origin.x, rect.origin.x + rect.size.width);
+static inline JMEGeometryWide JMERectGetMaxX(JMERect rect) {
+    return (JMEGeometryWide)rect.origin.x + rect.size.width;
 }
 
 /**
  *  Return the bottommost y-value of `rect'.
  */
-inline JMEGeometryUnit JMERectGetMinY(JMERect rect) {
-    return JMEMin(rect.origin.y, rect.origin.y + rect.size.height);
+static inline JMEGeometryUnit JMERectGetMinY(JMERect rect) {
+    return rect.origin.y;
 }
 
 /**
  *  Return the midpoint y-value of `rect'.
  */
-inline JMEGeometryUnit JMERectGetMidY(JMERect rect) {
-    return rect.origin.y + rect.size.height / 2;
+static inline JMEGeometryWide JMERectGetMidY(JMERect rect) {
+    return (JMEGeometryWide)rect.origin.y + rect.size.height / 2;
 }
 
 /**
- *  Return the topmost y-value of `rect'.
+ *  Return the topmost y-value of `rect', one past its last row.
  */
-inline JMEGeometryUnit JMERectGetMaxY(JMERect rect) {
-    return JMEMax(rect.origin.y, rect.origin.y + rect.size.height);
+static inline JMEGeometryWide JMERectGetMaxY(JMERect rect) {
+    return (JMEGeometryWide)rect.origin.y + rect.size.height;
 }
 
 /**
  *  Return true if `point1' and `point2' are the same, false otherwise.
  */
-inline BOOL JMEPointEqualToPoint(JMEPoint point1, JMEPoint point2) {
+static inline BOOL JMEPointEqualToPoint(JMEPoint point1, JMEPoint point2) {
     return JMEGeometryUnitEqual(point1.x, point2.x) && JMEGeometryUnitEqual(point1.y, point2.y);
 }
 
 /**
  *  Return true if `size1' and `size2' are the same, false otherwise.
  */
-inline BOOL JMESizeEqualToSize(JMESize size1, JMESize size2) {
+static inline BOOL JMESizeEqualToSize(JMESize size1, JMESize size2) {
     return JMEGeometryUnitEqual(size1.width, size2.width) && JMEGeometryUnitEqual(size1.height, size2.height);
 }
 
 /**
  *  Return true if `rect1' and `rect2' are the same, false otherwise.
  */
-inline BOOL JMERectEqualToRect(JMERect rect1, JMERect rect2) {
-    return JMEGeometryUnitEqual(rect1.origin.x, rect2.origin.x) &&
-    JMEGeometryUnitEqual(rect1.origin.y, rect2.origin.y) &&
-    JMEGeometryUnitEqual(rect1.size.width, rect2.size.width) &&
+static inline BOOL JMERectEqualToRect(JMERect rect1, JMERect rect2) {
+    return JMEGeometryUnitEqual(rect1.origin.x, rect2.origin.x) &
+    JMEGeometryUnitEqual(rect1.origin.y, rect2.origin.y) &
+    JMEGeometryUnitEqual(rect1.size.width, rect2.size.width) &
     JMEGeometryUnitEqual(rect1.size.height, rect2.size.height);
 }
 
@@ -184,94 +191,99 @@ inline BOOL JMERectEqualToRect(JMERect rect1, JMERect rect2) {
  *  Return true if `rect' is empty (that is, if it has zero width or height),
  *  false otherwise. A null rect is defined to be empty.
  */
-inline BOOL JMERectIsEmpty(JMERect rect) {
-    return JMEGeometryUnitEqual(rect.size.width, 0) || JMEGeometryUnitEqual(rect.size.height, 0);
+static inline BOOL JMERectIsEmpty(JMERect rect) {
+    return JMEGeometryUnitEqual(rect.size.width, 0) | JMEGeometryUnitEqual(rect.size.height, 0);
 }
 
 /**
  *  Return true if `rect' is the null rectangle, false otherwise.
  */
-inline BOOL JMERectIsNull(JMERect rect) {
-    return JMEGeometryUnitEqual(rect.size.width, 0) || JMEGeometryUnitEqual(rect.size.height, 0);
+static inline BOOL JMERectIsNull(JMERect rect) {
+    return JMERectIsEmpty(rect);
 }
 
 /**
- *  Inset `rect' by `(dx, dy)' -- i.e., offset its origin by `(dx, dy)', and
- *  decrease its size by `(2*dx, 2*dy)'.
+ *  Make a rect from the edges `(minX, minY)' and `(maxX, maxY)' of an
+ *  intersection. Edges that do not enclose any pixel give the null rect; the
+ *  choice is made with masks, not branches.
  */
-inline JMERect JMERectInset(JMERect rect, JMEGeometryUnit dx, JMEGeometryUnit dy) {
-    rect.origin.x += dx;
-    rect.origin.y += dy;
-    rect.size.width -= dx + dx;
-    rect.size.height -= dy + dy;
+static inline JMERect JMERectMakeEdges(JMEGeometryWide minX, JMEGeometryWide minY,
+                                       JMEGeometryWide maxX, JMEGeometryWide maxY) {
+    JMERect rect;
+    JMEGeometryWide mask = -(JMEGeometryWide)((minX < maxX) & (minY < maxY));
+    rect.origin.x = (JMEGeometryUnit)(minX & mask);
+    rect.origin.y = (JMEGeometryUnit)(minY & mask);
+    rect.size.width = (JMEGeometryUnit)((maxX - minX) & mask);
+    rect.size.height = (JMEGeometryUnit)((maxY - minY) & mask);
     return rect;
 }
 
 /**
- *  Return the union of `r1' and `r2'.
+ *  Inset `rect' by `(dx, dy)' -- i.e., offset its origin by `(dx, dy)', and
+ *  decrease its size by `(2*dx, 2*dy)'. Insetting by half the size or more
+ *  gives the null rect.
+ */
+static inline JMERect JMERectInset(JMERect rect, JMEGeometryUnit dx, JMEGeometryUnit dy) {
+    JMEGeometryWide minX = (JMEGeometryWide)rect.origin.x + dx;
+    JMEGeometryWide minY = (JMEGeometryWide)rect.origin.y + dy;
+    return JMERectMakeEdges(minX, minY, JMERectGetMaxX(rect) - dx, JMERectGetMaxY(rect) - dy);
+}
+
+/**
+ *  Return the union of `r1' and `r2', the smallest rect holding both. An
+ *  empty rect adds nothing. Sizes past JMEGeometryUnitMax are clamped.
  */
-inline JMERect JMERectUnion(JMERect r1, JMERect r2) {
+static inline JMERect JMERectUnion(JMERect r1, JMERect r2) {
     JMERect unionRect;
-    JMEGeometryUnit r1MinX = JMEMin(r1.origin.x, r1.origin.x + r1.size.width);
-    JMEGeometryUnit r1MaxX = JMEMax(r1.origin.x, r1.origin.x + r1.size.width);
-    JMEGeometryUnit r1MinY = JMEMin(r1.origin.y, r1.origin.y + r1.size.height);
-    JMEGeometryUnit r1MaxY = JMEMax(r1.origin.y, r1.origin.y + r1.size.height);
-
-    JMEGeometryUnit r2MinX = JMEMin(r2.origin.x, r2.origin.x + r2.size.width);
-    JMEGeometryUnit r2MaxX = JMEMax(r2.origin.x, r2.origin.x + r2.size.width);
-    JMEGeometryUnit r2MinY = JMEMin(r2.origin.y, r2.origin.y + r2.size.height);
-    JMEGeometryUnit r2MaxY = JMEMax(r2.origin.y, r2.origin.y + r2.size.height);
-
-    unionRect.origin.x = JMEMin(r1MinX, r2MinX);
-    unionRect.origin.y = JMEMin(r1MinY, r2MinY);
-    unionRect.size.width = JMEMax(r1MaxX, r2MaxX) - unionRect.origin.x;
-    unionRect.size.height = JMEMax(r1MaxY, r2MaxY) - unionRect.origin.y;
+    JMEGeometryWide maxX, maxY;
+    //
+    // an empty operand is replaced by the other one, chosen with masks; the
+    // union of a rect with itself is that rect
+    JMEGeometryUnit mask = -(JMEGeometryUnit)JMERectIsEmpty(r1);
+    r1.origin.x = (r1.origin.x & ~mask) | (r2.origin.x & mask);
+    r1.origin.y = (r1.origin.y & ~mask) | (r2.origin.y & mask);
+    r1.size.width = (r1.size.width & ~mask) | (r2.size.width & mask);
+    r1.size.height = (r1.size.height & ~mask) | (r2.size.height & mask);
+    mask = -(JMEGeometryUnit)JMERectIsEmpty(r2);
+    r2.origin.x = (r2.origin.x & ~mask) | (r1.origin.x & mask);
+    r2.origin.y = (r2.origin.y & ~mask) | (r1.origin.y & mask);
+    r2.size.width = (r2.size.width & ~mask) | (r1.size.width & mask);
+    r2.size.height = (r2.size.height & ~mask) | (r1.size.height & mask);
+    unionRect.origin.x = JMEMin(r1.origin.x, r2.origin.x);
+    unionRect.origin.y = JMEMin(r1.origin.y, r2.origin.y);
+    maxX = JMEMax(JMERectGetMaxX(r1), JMERectGetMaxX(r2)) - unionRect.origin.x;
+    maxY = JMEMax(JMERectGetMaxY(r1), JMERectGetMaxY(r2)) - unionRect.origin.y;
+    unionRect.size.width = (JMEGeometryUnit)JMEMin(maxX, JMEGeometryUnitMax);
+    unionRect.size.height = (JMEGeometryUnit)JMEMin(maxY, JMEGeometryUnitMax);
     return unionRect;
 }
 
 /**
  *  Return the intersection of `r1' and `r2'. This may return a null rect.
  */
-inline JMERect JMERectIntersection(JMERect r1, JMERect r2) {
-    JMERect intersectionRect;
-    JMEGeometryUnit r1MinX = JMEMin(r1.origin.x, r1.origin.x + r1.size.width);
-    JMEGeometryUnit r1MaxX = JMEMax(r1.origin.x, r1.origin.x + r1.size.width);
-    JMEGeometryUnit r1MinY = JMEMin(r1.origin.y, r1.origin.y + r1.size.height);
-    JMEGeometryUnit r1MaxY = JMEMax(r1.origin.y, r1.origin.y + r1.size.height);
-
-    JMEGeometryUnit r2MinX = JMEMin(r2.origin.x, r2.origin.x + r2.size.width);
-    JMEGeometryUnit r2MaxX = JMEMax(r2.origin.x, r2.origin.x + r2.size.width);
-    JMEGeometryUnit r2MinY = JMEMin(r2.origin.y, r2.origin.y + r2.size.height);
-    JMEGeometryUnit r2MaxY = JMEMax(r2.origin.y, r2.origin.y + r2.size.height);
-    if (r1MinX <= r2MinX && r1MinY <= r2MinY && r1MaxX > r2MinX && r1MaxY > r2MinY) {
-        intersectionRect.origin.x = r2MinX;
-        intersectionRect.origin.y = r2MinY;
-        intersectionRect.size.width = JMEMin(r1MaxX, r2MaxX) - r2MinX;
-        intersectionRect.size.height = JMEMin(r1MaxY, r2MaxY) - r2MinY;
-    } else if (r2MinX <= r1MinX && r2MinY <= r1MinY && r2MaxX > r1MinX && r2MaxY > r1MinY) {
-        intersectionRect.origin.x = r1MinX;
-        intersectionRect.origin.y = r1MinY;
-        intersectionRect.size.width = JMEMin(r2MaxX, r1MaxX) - r1MinX;
-        intersectionRect.size.height = JMEMin(r2MaxY, r1MaxY) - r1MinY;
-    }
-    return intersectionRect;
+static inline JMERect JMERectIntersection(JMERect r1, JMERect r2) {
+    return JMERectMakeEdges(JMEMax(r1.origin.x, r2.origin.x),
+                            JMEMax(r1.origin.y, r2.origin.y),
+                            JMEMin(JMERectGetMaxX(r1), JMERectGetMaxX(r2)),
+                            JMEMin(JMERectGetMaxY(r1), JMERectGetMaxY(r2)));
 }
 
 /**
- *  Offset `rect' by `(dx, dy)'.
+ *  Offset `rect' by `(dx, dy)'. The origin wraps within JMEGeometryUnit.
  */
-inline JMERect JMERectOffset(JMERect rect, JMEGeometryUnit dx, JMEGeometryUnit dy) {
-    rect.origin.x -= dx;
-    rect.origin.y -= dy;
+static inline JMERect JMERectOffset(JMERect rect, JMEGeometryUnit dx, JMEGeometryUnit dy) {
+    rect.origin.x += dx;
+    rect.origin.y += dy;
     return rect;
 }
 
 /**
- *  Return true if `point' is contained in `rect', false otherwise.
+ *  Return true if `point' is contained in `rect', false otherwise. The right
+ *  and bottom edges are outside, so an empty rect contains no point.
  */
-inline BOOL JMERectContainsPoint(JMERect rect, JMEPoint point) {
-    return JMERectGetMinX(rect) <= point.x && JMERectGetMaxX(rect) >= point.x &&
-    JMERectGetMinY(rect) <= point.y && JMERectGetMaxY(rect) >= point.y;
+static inline BOOL JMERectContainsPoint(JMERect rect, JMEPoint point) {
+    return (rect.origin.x <= point.x) & (point.x < JMERectGetMaxX(rect)) &
+    (rect.origin.y <= point.y) & (point.y < JMERectGetMaxY(rect));
 }
 
 /**
@@ -279,29 +291,28 @@ inline BOOL JMERectContainsPoint(JMERect rect, JMEPoint point) {
  *  is contained in `rect1' if the union of `rect1' and `rect2' is equal to
  *  `rect1'.
  */
-inline BOOL JMERectContainsRect(JMERect rect1, JMERect rect2) {
-    return JMERectGetMinX(rect1) < JMERectGetMinX(rect2) && JMERectGetMaxX(rect1) > JMERectGetMaxX(rect2) &&
-    JMERectGetMidY(rect1) < JMERectGetMinY(rect2) && JMERectGetMaxY(rect1) > JMERectGetMaxY(rect2);
+static inline BOOL JMERectContainsRect(JMERect rect1, JMERect rect2) {
+    return JMERectIsEmpty(rect2) |
+    ((rect1.origin.x <= rect2.origin.x) & (JMERectGetMaxX(rect2) <= JMERectGetMaxX(rect1)) &
+     (rect1.origin.y <= rect2.origin.y) & (JMERectGetMaxY(rect2) <= JMERectGetMaxY(rect1)));
 }
 
 /**
  *  Return true if `rect1' intersects `rect2', false otherwise. `rect1'
- * intersects `rect2' if the intersection of `rect1' and `rect2' is not the
- * null rect..
- */
-inline BOOL JMERectIntersectsRect(JMERect rect1, JMERect rect2) {
-    JMEGeometryUnit rect1MinX = JMEMin(rect1.origin.x, rect1.origin.x + rect1.size.width);
-    JMEGeometryUnit rect1MaxX = JMEMax(rect1.origin.x, rect1.origin.x + rect1.size.width);
-    JMEGeometryUnit rect1MinY = JMEMin(rect1.origin.y, rect1.origin.y + rect1.size.height);
-    JMEGeometryUnit rect1MaxY = JMEMax(rect1.origin.y, rect1.origin.y + rect1.size.height);
-
-    JMEGeometryUnit rect2MinX = JMEMin(rect2.origin.x, rect2.origin.x + rect2.size.width);
-    JMEGeometryUnit rect2MaxX = JMEMax(rect2.origin.x, rect2.origin.x + rect2.size.width);
-    JMEGeometryUnit rect2MinY = JMEMin(rect2.origin.y, rect2.origin.y + rect2.size.height);
-    JMEGeometryUnit rect2MaxY = JMEMax(rect2.origin.y, rect2.origin.y + rect2.size.height);
-
-    return (rect1MinX <= rect2MinX && rect1MinY <= rect2MinY && rect1MaxX > rect2MinX && rect1MaxY > rect2MinY) ||
-    (rect2MinX <= rect1MinX && rect2MinY <= rect1MinY && rect2MaxX > rect1MinX && rect2MaxY > rect1MinY);
+ *  intersects `rect2' if the intersection of `rect1' and `rect2' is not the
+ *  null rect.
+ */
+static inline BOOL JMERectIntersectsRect(JMERect rect1, JMERect rect2) {
+    return (JMEMax(rect1.origin.x, rect2.origin.x) < JMEMin(JMERectGetMaxX(rect1), JMERectGetMaxX(rect2))) &
+    (JMEMax(rect1.origin.y, rect2.origin.y) < JMEMin(JMERectGetMaxY(rect1), JMERectGetMaxY(rect2)));
 }
 
+/**
+ *  Intersect `rect' with each of the `count' rects in `rects', storing the
+ *  results in `intersections' (null where they do not meet; may be NULL when
+ *  only the count is wanted). Return the number of rects `rect' intersects.
+ */
+JME_EXTERN uint16_t JMERectIntersectRects(JMERect rect, const JMERect * rects, uint16_t count,
+                                          JMERect * intersections);
+
 #endif /* defined(__H__JMEGeometry__H__) */
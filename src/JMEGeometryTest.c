@@ -0,0 +1,214 @@
+/**
+ Filename:       JMEGeometryTest.c
+ Revised:        $Date: 2015-06-18$
+ Revision:       $Revision: 01 $
+ Author:         Oborn.Jung
+
+ Description:    This file contains the host test of the geometry kernels. Each
+                 kernel is compared with the same operation done on plain ints,
+                 for every rect and point built from the boundary values below.
+                 Build with JMEGEOMETRY_TEST_MAIN defined, see `make test'.
+
+ Copyright 2015 JONMA Inc. All rights reserved.
+ */
+
+#if defined(JMEGEOMETRY_TEST_MAIN)
+
+/*********************************************************************
+ * INCLUDES
+ */
+#include <stdio.h>
+#include "JMEGeometry.h"
+
+/*********************************************************************
+ * MACROS
+ */
+#define JMEGEOMETRYTEST_VALUES          (sizeof(_values) / sizeof(_values[0]))
+#define JMEGEOMETRYTEST_RECTS           (JMEGEOMETRYTEST_VALUES * JMEGEOMETRYTEST_VALUES * \
+                                         JMEGEOMETRYTEST_VALUES * JMEGEOMETRYTEST_VALUES)
+#define JMEGEOMETRYTEST_REPORTS         8       ///< failures printed
+
+/*********************************************************************
+ * TYPEDEFS
+ */
+/**
+ *  A rect as plain ints: edges, right and bottom one past the last pixel.
+ */
+typedef struct {
+    int                 minX, minY;
+    int                 maxX, maxY;
+}JMEGeometryTestEdges_t;
+
+/*********************************************************************
+ * LOCAL VARIABLES
+ */
+//
+// both ends of the unit, the middle and its neighbours, and a few values
+// whose sums with each other pass the end of the unit
+static const uint8_t _values[] = {0, 1, 2, 3, 100, 127, 128, 129, 200, 254, 255};
+static JMERect _rects[JMEGEOMETRYTEST_RECTS];
+static JMERect _intersections[JMEGEOMETRYTEST_RECTS];
+static unsigned long _failures;
+
+/*********************************************************************
+ * LOCAL FUNCTIONS
+ */
+static int _JMEGeometryTest_min(int a, int b) { return a < b ? a : b; }
+static int _JMEGeometryTest_max(int a, int b) { return a > b ? a : b; }
+
+static JMEGeometryTestEdges_t _JMEGeometryTest_edges(JMERect rect)
+{
+    JMEGeometryTestEdges_t edges;
+    edges.minX = rect.origin.x;
+    edges.minY = rect.origin.y;
+    edges.maxX = rect.origin.x + rect.size.width;
+    edges.maxY = rect.origin.y + rect.size.height;
+    return edges;
+}
+
+static int _JMEGeometryTest_isEmpty(JMEGeometryTestEdges_t edges)
+{
+    return edges.minX >= edges.maxX || edges.minY >= edges.maxY;
+}
+
+/**
+ *  The rect of `edges', or the null rect when they enclose no pixel.
+ */
+static JMERect _JMEGeometryTest_rect(JMEGeometryTestEdges_t edges)
+{
+    if (_JMEGeometryTest_isEmpty(edges)) {
+        return JMERectNull;
+    }
+    return JMERectMake(edges.minX, edges.minY, edges.maxX - edges.minX, edges.maxY - edges.minY);
+}
+
+static JMEGeometryTestEdges_t _JMEGeometryTest_intersection(JMEGeometryTestEdges_t a, JMEGeometryTestEdges_t b)
+{
+    JMEGeometryTestEdges_t edges;
+    edges.minX = _JMEGeometryTest_max(a.minX, b.minX);
+    edges.minY = _JMEGeometryTest_max(a.minY, b.minY);
+    edges.maxX = _JMEGeometryTest_min(a.maxX, b.maxX);
+    edges.maxY = _JMEGeometryTest_min(a.maxY, b.maxY);
+    return edges;
+}
+
+static void _JMEGeometryTest_fail(const char * kernel, JMERect r1, JMERect r2)
+{
+    if (_failures ++ < JMEGEOMETRYTEST_REPORTS) {
+        printf("%s: (%u, %u; %u, %u) (%u, %u; %u, %u)\n", kernel,
+               r1.origin.x, r1.origin.y, r1.size.width, r1.size.height,
+               r2.origin.x, r2.origin.y, r2.size.width, r2.size.height);
+    }
+}
+
+static void _JMEGeometryTest_expect(BOOL isPassed, const char * kernel, JMERect r1, JMERect r2)
+{
+    if (!isPassed) {
+        _JMEGeometryTest_fail(kernel, r1, r2);
+    }
+}
+
+/**
+ *  Kernels of one rect with a point, a pair of units or a list of rects.
+ */
+static void _JMEGeometryTest_single(JMERect rect)
+{
+    JMEGeometryTestEdges_t edges = _JMEGeometryTest_edges(rect);
+    JMERect none = JMERectZero;
+    uint32_t hits = 0;
+
+    for (uint8_t i = 0; i < JMEGEOMETRYTEST_VALUES; i ++) {
+        for (uint8_t j = 0; j < JMEGEOMETRYTEST_VALUES; j ++) {
+            int x = _values[i], y = _values[j];
+            JMEGeometryTestEdges_t inset = {edges.minX + x / 2, edges.minY + y / 2,
+                                            edges.maxX - x / 2, edges.maxY - y / 2};
+            JMERect point = JMERectMake(x, y, 0, 0);
+            BOOL isInside = x >= edges.minX && x < edges.maxX && y >= edges.minY && y < edges.maxY;
+            JMERect offset = JMERectMake((uint8_t)(rect.origin.x + x), (uint8_t)(rect.origin.y + y),
+                                         rect.size.width, rect.size.height);
+            JMEGeometryTestEdges_t corner = {edges.minX, edges.minY, x, y};
+
+            _JMEGeometryTest_expect(JMERectContainsPoint(rect, JMEPointMake(x, y)) == isInside,
+                                    "JMERectContainsPoint", rect, point);
+            _JMEGeometryTest_expect(JMERectEqualToRect(JMERectInset(rect, x / 2, y / 2), _JMEGeometryTest_rect(inset)),
+                                    "JMERectInset", rect, point);
+            _JMEGeometryTest_expect(JMERectEqualToRect(JMERectOffset(rect, x, y), offset),
+                                    "JMERectOffset", rect, point);
+            //
+            // edges from the origin of `rect' to the point, which may lie on
+            // either side of it
+            _JMEGeometryTest_expect(JMERectEqualToRect(JMERectMakeEdges(edges.minX, edges.minY, x, y),
+                                                       _JMEGeometryTest_rect(corner)),
+                                    "JMERectMakeEdges", rect, point);
+        }
+    }
+    for (uint32_t n = 0; n < JMEGEOMETRYTEST_RECTS; n ++) {
+        hits += !_JMEGeometryTest_isEmpty(_JMEGeometryTest_intersection(edges, _JMEGeometryTest_edges(_rects[n])));
+    }
+    _JMEGeometryTest_expect(JMERectIntersectRects(rect, _rects, JMEGEOMETRYTEST_RECTS, NULL) == (uint16_t)hits,
+                            "JMERectIntersectRects", rect, none);
+}
+
+/**
+ *  Kernels of two rects. JMERectIntersectRects of `r1' with every rect has
+ *  already filled `_intersections'.
+ */
+static void _JMEGeometryTest_pair(JMERect r1, JMERect r2, JMERect intersection)
+{
+    JMEGeometryTestEdges_t a = _JMEGeometryTest_edges(r1), b = _JMEGeometryTest_edges(r2);
+    JMEGeometryTestEdges_t common = _JMEGeometryTest_intersection(a, b);
+    BOOL isEmpty1 = _JMEGeometryTest_isEmpty(a), isEmpty2 = _JMEGeometryTest_isEmpty(b);
+    BOOL isContained = isEmpty2 ||
+    (a.minX <= b.minX && b.maxX <= a.maxX && a.minY <= b.minY && b.maxY <= a.maxY);
+    JMERect unionRect;
+
+    if (isEmpty1) {
+        unionRect = r2;
+    } else if (isEmpty2) {
+        unionRect = r1;
+    } else {
+        int minX = _JMEGeometryTest_min(a.minX, b.minX), minY = _JMEGeometryTest_min(a.minY, b.minY);
+        int width = _JMEGeometryTest_max(a.maxX, b.maxX) - minX;
+        int height = _JMEGeometryTest_max(a.maxY, b.maxY) - minY;
+        unionRect = JMERectMake(minX, minY, _JMEGeometryTest_min(width, 255), _JMEGeometryTest_min(height, 255));
+    }
+
+    _JMEGeometryTest_expect(JMERectEqualToRect(JMERectIntersection(r1, r2), _JMEGeometryTest_rect(common)),
+                            "JMERectIntersection", r1, r2);
+    _JMEGeometryTest_expect(JMERectEqualToRect(intersection, _JMEGeometryTest_rect(common)),
+                            "JMERectIntersectRects", r1, r2);
+    _JMEGeometryTest_expect(JMERectIntersectsRect(r1, r2) == !_JMEGeometryTest_isEmpty(common),
+                            "JMERectIntersectsRect", r1, r2);
+    _JMEGeometryTest_expect(JMERectContainsRect(r1, r2) == isContained,
+                            "JMERectContainsRect", r1, r2);
+    _JMEGeometryTest_expect(JMERectEqualToRect(JMERectUnion(r1, r2), unionRect),
+                            "JMERectUnion", r1, r2);
+}
+
+/*********************************************************************
+ * IMPLEMENT OF PUBLIC FUNCTIONS
+ */
+int main(void)
+{
+    uint32_t count = 0;
+    for (uint8_t x = 0; x < JMEGEOMETRYTEST_VALUES; x ++) {
+        for (uint8_t y = 0; y < JMEGEOMETRYTEST_VALUES; y ++) {
+            for (uint8_t width = 0; width < JMEGEOMETRYTEST_VALUES; width ++) {
+                for (uint8_t height = 0; height < JMEGEOMETRYTEST_VALUES; height ++) {
+                    _rects[count ++] = JMERectMake(_values[x], _values[y], _values[width], _values[height]);
+                }
+            }
+        }
+    }
+    for (uint32_t i = 0; i < JMEGEOMETRYTEST_RECTS; i ++) {
+        JMERectIntersectRects(_rects[i], _rects, JMEGEOMETRYTEST_RECTS, _intersections);
+        _JMEGeometryTest_single(_rects[i]);
+        for (uint32_t j = 0; j < JMEGEOMETRYTEST_RECTS; j ++) {
+            _JMEGeometryTest_pair(_rects[i], _rects[j], _intersections[j]);
+        }
+    }
+    printf("%lu rect pairs, %lu failure(s)\n", (unsigned long)JMEGEOMETRYTEST_RECTS * JMEGEOMETRYTEST_RECTS, _failures);
+    return _failures > 0 ? 1 : 0;
+}
+
+#endif /* defined(JMEGEOMETRY_TEST_MAIN) */
@@ -11,6 +11,39 @@
 #include "JMEST7735R_Adapter.h"
 #include "JMEST7735R_DriveLib.h"
 
+static void _JMEST7735R_select(void * context, BOOL isSelected);
+static void _JMEST7735R_writeCommand(void * context, uint8_t cmd);
+static void _JMEST7735R_writeBlock(void * context, const uint8_t * data, uint16_t length);
+static void _JMEST7735R_fillRepeat(void * context, uint16_t color, uint16_t count);
+static void _JMEST7735R_readBlock(void * context, uint8_t * data, uint16_t length);
+static void _JMEST7735R_setReset(void * context, BOOL isActive);
+static void _JMEST7735R_setBacklight(void * context, BOOL isOn);
+#if JMEST7735R_USE_ASYNC
+static void _JMEST7735R_startBlock(void * context, JMEST7735RDisplay_t * display, const uint8_t * data, uint16_t length);
+static void _JMEST7735R_waitBlock(void * context);
+#endif
+
+//
+// 8080 parallel bus driven through the port macros
+const JMEST7735RAdapter_t kJMEST7735RDefaultAdapter = {
+    NULL,
+    _JMEST7735R_select,
+    _JMEST7735R_writeCommand,
+    _JMEST7735R_writeBlock,
+    _JMEST7735R_fillRepeat,
+    _JMEST7735R_readBlock,
+    _JMEST7735R_setReset,
+    _JMEST7735R_setBacklight,
+#if JMEST7735R_USE_ASYNC
+    _JMEST7735R_startBlock,
+    _JMEST7735R_waitBlock,
+#else
+    NULL,
+    NULL,
+#endif
+    NULL,
+};
+
 void JMEST7735R_portInit(void)
 {
 	//
@@ -25,3 +58,99 @@ void JMEST7735R_IOEnterSleep(BOOL isSleep) {
         
     }
 }
+
+#if JMEST7735R_USE_ASYNC && !defined(JMEST7735R_HOST_SIM)
+//
+// arm the DMA channel for `length' bytes from `data' to the bus port and call
+// JMEST7735RDisplay_blockWriteDone(display) from its completion interrupt.
+// Until the channel is configured the block is written here and completes at
+// once.
+void JMEST7735R_DMAWrite(JMEST7735RDisplay_t * display, const uint8_t * data, uint16_t length)
+{
+    while (length --) {
+        JMEST7735R_RWCLR();
+        JMEST7735R_writeByte(*data ++);
+        JMEST7735R_RWSET();
+    }
+    JMEST7735RDisplay_blockWriteDone(display);
+}
+#endif
+
+static void _JMEST7735R_select(void * context, BOOL isSelected)
+{
+    if (isSelected) {
+        JMEST7735R_RDSET();
+        JMEST7735R_CSCLR();
+    } else {
+        JMEST7735R_NOP();JMEST7735R_NOP();
+        JMEST7735R_CSSET();
+    }
+}
+
+static void _JMEST7735R_writeCommand(void * context, uint8_t cmd)
+{
+    JMEST7735R_CDCLR();
+    JMEST7735R_seqWrite(cmd);
+}
+
+static void _JMEST7735R_writeBlock(void * context, const uint8_t * data, uint16_t length)
+{
+    JMEST7735R_CDSET();
+    while (length --) {
+        JMEST7735R_seqWrite(*data ++);
+    }
+}
+
+static void _JMEST7735R_fillRepeat(void * context, uint16_t color, uint16_t count)
+{
+    uint8_t high = (uint8_t)(color >> 8);
+    uint8_t low = (uint8_t)color;
+    JMEST7735R_CDSET();
+    while (count --) {
+        JMEST7735R_seqWrite(high);
+        JMEST7735R_seqWrite(low);
+    }
+}
+
+static void _JMEST7735R_readBlock(void * context, uint8_t * data, uint16_t length)
+{
+    JMEST7735R_CDSET();
+    JMEST7735R_RWSET();
+    while (length --) {
+        JMEST7735R_RDCLR();
+        JMEST7735R_NOP();JMEST7735R_NOP();
+        JMEST7735R_RDSET();
+        *data ++ = JMEST7735R_readByte();
+    }
+}
+
+static void _JMEST7735R_setReset(void * context, BOOL isActive)
+{
+    if (isActive) {
+        JMEST7735R_RESETENABLE();
+    } else {
+        JMEST7735R_RESETDISABLE();
+    }
+}
+
+static void _JMEST7735R_setBacklight(void * context, BOOL isOn)
+{
+    if (isOn) {
+        JMEST7735R_LEDON();
+    } else {
+        JMEST7735R_LEDOFF();
+    }
+}
+
+#if JMEST7735R_USE_ASYNC
+static void _JMEST7735R_startBlock(void * context, JMEST7735RDisplay_t * display, const uint8_t * data, uint16_t length)
+{
+    JMEST7735R_CDSET();
+    JMEST7735R_startBlockWrite(display, data, length);
+}
+
+static void _JMEST7735R_waitBlock(void * context)
+{
+    JMEST7735R_waitBlockWrite();
+}
+#endif
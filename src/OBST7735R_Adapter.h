@@ -11,6 +11,33 @@
 #ifndef __H__JMEST7735R_Adapter_H__
 #define __H__JMEST7735R_Adapter_H__
 
+#if defined(JMEST7735R_HOST_SIM)
+//
+// host build: every bus access is routed to the software panel model
+#include "JMEBase.h"
+#include "OBST7735R_Simulator.h"
+
+#define JMEST7735R_RESETENABLE()        JMEST7735RSim_setReset(TRUE)
+#define JMEST7735R_RESETDISABLE()       JMEST7735RSim_setReset(FALSE)
+#define JMEST7735R_CDSET()              JMEST7735RSim_setCD(TRUE)
+#define JMEST7735R_CDCLR()              JMEST7735RSim_setCD(FALSE)
+#define JMEST7735R_RWSET()
+#define JMEST7735R_RWCLR()
+#define JMEST7735R_RDSET()
+#define JMEST7735R_RDCLR()
+#define JMEST7735R_CSSET()              JMEST7735RSim_setCS(TRUE)
+#define JMEST7735R_CSCLR()              JMEST7735RSim_setCS(FALSE)
+#define JMEST7735R_LEDON()              JMEST7735RSim_setBacklight(TRUE)
+#define JMEST7735R_LEDOFF()             JMEST7735RSim_setBacklight(FALSE)
+#define JMEST7735R_delayMS(n)           JMEST7735RSim_delayMS(n)
+#define JMEST7735R_writeByte(byte)      JMEST7735RSim_writeByte(byte)
+#define JMEST7735R_readByte()           JMEST7735RSim_readByte()
+#define JMEST7735R_startBlockWrite(display, data, length)   JMEST7735RSim_startBlockWrite((display), (data), (length))
+#define JMEST7735R_waitBlockWrite()     JMEST7735RSim_waitBlockWrite()
+
+#define JMEST7735R_NOP()
+
+#else
 #include <ioCC2540.h>
 #include "JMEBase.h"
 #include "JMESystem.h"
@@ -32,8 +59,17 @@
 #define JMEST7735R_writeByte(byte)	
 #define JMEST7735R_readByte()	
 
+#define JMEST7735R_startBlockWrite(display, data, length)   JMEST7735R_DMAWrite((display), (data), (length))
+#define JMEST7735R_waitBlockWrite()
+
 #define JMEST7735R_NOP()                ASM_NOP
 
+struct JMEST7735RDisplay;
+JME_EXTERN void JMEST7735R_DMAWrite(struct JMEST7735RDisplay * display, const uint8_t * data, uint16_t length);
+#endif
+
+#define JMEST7735R_seqWrite(byte)  JMEST7735R_RWCLR(); JMEST7735R_writeByte((byte)); JMEST7735R_RWSET();
+
 JME_EXTERN void JMEST7735R_portInit(void);
 JME_EXTERN void JMEST7735R_IOEnterSleep(BOOL isSleep);
 
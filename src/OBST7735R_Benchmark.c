@@ -0,0 +1,442 @@
+/**
+ Filename:       OBST7735R_Benchmark.c
+ Revised:        $Date: 2015-06-18$
+ Revision:       $Revision: 01 $
+
+ Description:    This file contains the per-primitive bus cost benchmark of the
+                 ST7735R driver. It runs on the host simulator only.
+
+ Copyright 2015 ObornJung. All rights reserved.
+ */
+
+#if defined(JMEST7735R_HOST_SIM)
+
+/*********************************************************************
+ * INCLUDES
+ */
+#include <time.h>
+#include "JMEBase.h"
+#include "JMEGeometry.h"
+#include "OBST7735R_DriveLib.h"
+#include "OBST7735R_Simulator.h"
+#include "OBST7735R_Benchmark.h"
+
+/*********************************************************************
+ * MACROS
+ */
+//
+// the feature configuration this build measures, one baseline column each:
+// draw calls go straight to the panel, through the async line buffers, into
+// the framebuffer sent by refreshScreen, or into a frame sent by endFrame
+#define JMEST7735RBENCH_DIRECT          0
+#define JMEST7735RBENCH_ASYNC           1
+#define JMEST7735RBENCH_FRAMEBUFFER     2
+#define JMEST7735RBENCH_BANDRENDER      3
+#define JMEST7735RBENCH_CONFIGS         4
+#if JMEST7735R_USE_BANDRENDER
+#define JMEST7735RBENCH_CONFIG          JMEST7735RBENCH_BANDRENDER
+#elif JMEST7735R_USE_FRAMEBUFFER
+#define JMEST7735RBENCH_CONFIG          JMEST7735RBENCH_FRAMEBUFFER
+#elif JMEST7735R_USE_ASYNC
+#define JMEST7735RBENCH_CONFIG          JMEST7735RBENCH_ASYNC
+#else
+#define JMEST7735RBENCH_CONFIG          JMEST7735RBENCH_DIRECT
+#endif
+
+/*********************************************************************
+ * TYPEDEFS
+ */
+typedef struct {
+    uint32_t            bytes;              ///< bytes on the wire
+    uint32_t            commands;           ///< command count
+    uint32_t            windowSets;         ///< CASET + RASET count
+    uint32_t            csCycles;           ///< chip select assertions
+}JMEST7735RBenchCost_t;
+
+typedef struct {
+    const char          * name;
+    void                (* run)(void);
+    JMEST7735RBenchCost_t baselines[JMEST7735RBENCH_CONFIGS];   ///< indexed by JMEST7735RBENCH_CONFIG
+    BOOL                (* check)(void);    ///< verifies what `run' computed, NULL for draw calls
+}JMEST7735RBenchCase_t;
+
+/*********************************************************************
+ * LOCAL VARIABLES
+ */
+//
+// proportional 5x7 digits and ':', inked boxes only
+static const uint8_t _digitAtlas[] = {
+    0x70, 0x88, 0x98, 0xA8, 0xC8, 0x88, 0x70,   // 0
+    0x40, 0xC0, 0x40, 0x40, 0x40, 0x40, 0xE0,   // 1
+    0x70, 0x88, 0x08, 0x70, 0x80, 0x80, 0xF8,   // 2
+    0xF8, 0x08, 0x10, 0x30, 0x08, 0x88, 0x70,   // 3
+    0x10, 0x30, 0x50, 0x90, 0xF8, 0x10, 0x10,   // 4
+    0xF8, 0x80, 0xF0, 0x08, 0x08, 0x88, 0x70,   // 5
+    0x38, 0x40, 0x80, 0xF0, 0x88, 0x88, 0x70,   // 6
+    0xF8, 0x08, 0x08, 0x10, 0x20, 0x40, 0x80,   // 7
+    0x70, 0x88, 0x88, 0x70, 0x88, 0x88, 0x70,   // 8
+    0x70, 0x88, 0x88, 0x78, 0x08, 0x10, 0xE0,   // 9
+    0x80, 0x00, 0x00, 0x80,                     // :
+};
+static const JMEST7735RFontGlyph_t _digitGlyphs[] = {
+    {0, 5, 7, 0, 0, 6},  {7, 3, 7, 0, 0, 4},  {14, 5, 7, 0, 0, 6}, {21, 5, 7, 0, 0, 6},
+    {28, 5, 7, 0, 0, 6}, {35, 5, 7, 0, 0, 6}, {42, 5, 7, 0, 0, 6}, {49, 5, 7, 0, 0, 6},
+    {56, 5, 7, 0, 0, 6}, {63, 5, 7, 0, 0, 6}, {70, 1, 4, 1, 2, 3},
+};
+static const JMEST7735RFont_t _digitFont = {_digitAtlas, _digitGlyphs, '0', 11, 8};
+
+static uint16_t _bitmap[32 * 32];
+static uint8_t _binaryImage[32 * 32 / 8];
+static uint8_t _indexedImage[32 * 32 / 2];
+static uint16_t _palette[16];
+static uint16_t _flatIcon[32 * 32];
+static uint8_t _flatIconRLE[32 * 32 * 3];
+static JMERect _rects[64];
+static JMERect _intersections[64];
+static uint16_t _geometryHits;
+static JMERect _geometryUnion;
+static JMEST7735RNumber_t _readout;
+static int32_t _readoutValue = 12340;
+#if JMEST7735R_USE_FRAMEBUFFER
+static uint16_t _framebuffer[JMEST7735R_FRAMEBUFFER_PIXELS];
+#endif
+#if JMEST7735R_USE_GLYPHCACHE
+static uint16_t _glyphArena[JMEST7735R_GLYPH_SLOT_BYTES * 16 / 2];
+#endif
+
+/*********************************************************************
+ * LOCAL FUNCTIONS
+ */
+static void _JMEST7735RBench_fillScreen(void)       { JMEST7735R_fillScreen(0x001F); }
+static void _JMEST7735RBench_lineHorizontal(void)   { JMEST7735R_drawLine(JMEPointMake(0, 80), JMEPointMake(127, 80), 0xF800); }
+static void _JMEST7735RBench_lineVertical(void)     { JMEST7735R_drawLine(JMEPointMake(64, 0), JMEPointMake(64, 159), 0xF800); }
+static void _JMEST7735RBench_lineShallow(void)      { JMEST7735R_drawLine(JMEPointMake(0, 10), JMEPointMake(120, 40), 0xF800); }
+static void _JMEST7735RBench_lineDiagonal(void)     { JMEST7735R_drawLine(JMEPointMake(0, 0), JMEPointMake(100, 100), 0xF800); }
+static void _JMEST7735RBench_lineSteep(void)        { JMEST7735R_drawLine(JMEPointMake(10, 0), JMEPointMake(40, 150), 0xF800); }
+static void _JMEST7735RBench_rectFilled(void)       { JMEST7735R_drawRect(JMERectMake(10, 10, 60, 40), 0x07E0, TRUE); }
+static void _JMEST7735RBench_rectOutline(void)      { JMEST7735R_drawRect(JMERectMake(10, 10, 60, 40), 0x07E0, FALSE); }
+static void _JMEST7735RBench_bitmap(void)           { JMEST7735R_drawBitmap(_bitmap, JMERectMake(20, 20, 32, 32), FALSE); }
+static void _JMEST7735RBench_compressed(void)     { JMEST7735R_drawCompressedBitmap(_flatIconRLE, JMERectMake(20, 20, 32, 32)); }
+static void _JMEST7735RBench_indexed(void)        { JMEST7735R_drawIndexedBitmap(_indexedImage, JMERectMake(20, 20, 32, 32), 4, _palette); }
+static void _JMEST7735RBench_binaryImage(void)      { JMEST7735R_drawBinaryImage(_binaryImage, JMERectMake(20, 20, 32, 32), 0xFFFF, 0x0000); }
+
+static void _JMEST7735RBench_binaryIcon(void)
+{
+    JMEMenuIcon_t icon;
+    icon.iconFrame = JMERectMake(0, 0, 48, 48);
+    icon.iconSize = JMESizeMake(32, 32);
+    icon.iconData = _binaryImage;
+    icon.color = 0xFFFF;
+    icon.bgColor = 0x0000;
+    JMEST7735R_drawBinaryIcon(&icon);
+}
+
+static void _JMEST7735RBench_menuIcon(void)
+{
+    JMEMenuIcon_t icon;
+    icon.iconFrame = JMERectMake(0, 0, 48, 48);
+    icon.iconSize = JMESizeMake(32, 32);
+    icon.iconData = (const uint8_t *)_bitmap;
+    icon.color = 0x0000;
+    icon.bgColor = 0x0000;
+    JMEST7735R_drawMenuIcon(&icon, FALSE);
+}
+
+/**
+ *  Greedy RLE encoder: a pixel repeated at least twice becomes a run, anything
+ *  else is gathered into literals. Returns the encoded size.
+ */
+static uint16_t _JMEST7735RBench_encodeRLE(const uint16_t * pixels, uint16_t count, uint8_t * out)
+{
+    uint8_t * start = out;
+    uint16_t i = 0;
+    while (i < count) {
+        uint16_t n = 1;
+        while (i + n < count && n < JMEST7735R_RLE_MAX_COUNT && pixels[i + n] == pixels[i]) {
+            n ++;
+        }
+        if (n > 1) {
+            *out ++ = JMEST7735R_RLE_RUN | (n - 1);
+            *out ++ = (uint8_t)(pixels[i] >> 8);
+            *out ++ = (uint8_t)pixels[i];
+        } else {
+            while (i + n < count && n < JMEST7735R_RLE_MAX_COUNT &&
+                   (i + n + 1 >= count || pixels[i + n] != pixels[i + n + 1])) {
+                n ++;
+            }
+            *out ++ = n - 1;
+            for (uint16_t k = 0; k < n; k ++) {
+                *out ++ = (uint8_t)(pixels[i + k] >> 8);
+                *out ++ = (uint8_t)pixels[i + k];
+            }
+        }
+        i += n;
+    }
+    return out - start;
+}
+
+static void _JMEST7735RBench_number(void)           { JMEST7735R_drawNumber(JMEPointMake(10, 10), 456, 0xFFFF, 0x0000, 2); }
+static void _JMEST7735RBench_string1(void)          { JMEST7735R_drawString(JMEPointMake(0, 0), "Hello, ST7735R!", 0xFFFF, 0x0000, 1); }
+static void _JMEST7735RBench_string2(void)          { JMEST7735R_drawString(JMEPointMake(0, 0), "Hello ST", 0xFFFF, 0x0000, 2); }
+static void _JMEST7735RBench_string3(void)          { JMEST7735R_drawString(JMEPointMake(0, 0), "Hello", 0xFFFF, 0x0000, 3); }
+static void _JMEST7735RBench_string4(void)          { JMEST7735R_drawString(JMEPointMake(0, 0), "Hi!", 0xFFFF, 0x0000, 4); }
+static void _JMEST7735RBench_text(void)             { JMEST7735R_drawText(JMEPointMake(0, 0), "12:45", &_digitFont, 0xFFFF, 0x0000); }
+static void _JMEST7735RBench_readout(void)          { JMEST7735R_updateNumber(&_readout, ++ _readoutValue); }
+
+static void _JMEST7735RBench_scrollLine(void)
+{
+    //
+    // console: move the log up one text line, draw the new bottom line
+    JMEST7735R_scroll(12);
+    JMEST7735R_drawString(JMEPointMake(0, 148), "log: 0123456789", 0xFFFF, 0x0000, 1);
+}
+
+static void _JMEST7735RBench_landscape(void)
+{
+    //
+    // a landscape label costs the same as in portrait plus two MADCTL writes
+    JMEST7735R_setRotation(JMEST7735R_ROTATION_90, FALSE);
+    JMEST7735R_drawString(JMEPointMake(0, 0), "Hello, ST7735R!", 0xFFFF, 0x0000, 1);
+    JMEST7735R_setRotation(JMEST7735R_ROTATION_0, FALSE);
+}
+
+static void _JMEST7735RBench_fillScreen12(void)
+{
+    JMEST7735R_setPixelFormat(JMEST7735R_IPF_12);
+    JMEST7735R_fillScreen(0x001F);
+    JMEST7735R_setPixelFormat(JMEST7735R_IPF_16);
+}
+
+static void _JMEST7735RBench_string12(void)
+{
+    JMEST7735R_setPixelFormat(JMEST7735R_IPF_12);
+    JMEST7735R_drawString(JMEPointMake(0, 0), "Hello, ST7735R!", 0xFFFF, 0x0000, 1);
+    JMEST7735R_setPixelFormat(JMEST7735R_IPF_16);
+}
+
+static void _JMEST7735RBench_partialStatus(void)
+{
+    //
+    // standby: only the status line is scanned, the rest of the frame is dropped
+    JMEST7735R_enterPartialMode(0, 12);
+    JMEST7735R_drawString(JMEPointMake(0, 0), "12:45", 0xFFFF, 0x0000, 1);
+    JMEST7735R_drawRect(JMERectMake(20, 40, 40, 40), 0xF800, TRUE);
+    JMEST7735R_exitPartialMode();
+}
+
+static void _JMEST7735RBench_clippedBitmap(void)
+{
+    //
+    // a scroll view: one bitmap half inside the view, one entirely outside
+    JMEST7735R_pushClip(JMERectMake(0, 16, 128, 64));
+    JMEST7735R_drawBitmap(_bitmap, JMERectMake(10, 0, 32, 32), FALSE);
+    JMEST7735R_drawBitmap(_bitmap, JMERectMake(10, 100, 32, 32), FALSE);
+    JMEST7735R_popClip();
+}
+
+static void _JMEST7735RBench_geometry(void)
+{
+    //
+    // CPU only: clip a moving rect against a list of widgets, then merge the
+    // parts of the widgets under its last position
+    JMERect unionRect = JMERectNull;
+    uint16_t hits = 0;
+    for (uint8_t i = 0; i < 16; i ++) {
+        JMERect rect = JMERectMake(i * 13, i * 7, 96, 80);
+        hits += JMERectIntersectRects(rect, _rects, 64, _intersections);
+    }
+    for (uint8_t i = 0; i < 64; i ++) {
+        unionRect = JMERectUnion(unionRect, _intersections[i]);
+    }
+    _geometryHits = hits;
+    _geometryUnion = unionRect;
+}
+
+/**
+ *  The geometry case done again on plain ints.
+ */
+static BOOL _JMEST7735RBench_checkGeometry(void)
+{
+    int16_t minX = 0x7FFF, minY = 0x7FFF, maxX = 0, maxY = 0;
+    uint16_t hits = 0;
+    for (uint8_t i = 0; i < 16; i ++) {
+        for (uint8_t n = 0; n < 64; n ++) {
+            int16_t x0 = JMEMax(i * 13, _rects[n].origin.x);
+            int16_t y0 = JMEMax(i * 7, _rects[n].origin.y);
+            int16_t x1 = JMEMin(i * 13 + 96, _rects[n].origin.x + _rects[n].size.width);
+            int16_t y1 = JMEMin(i * 7 + 80, _rects[n].origin.y + _rects[n].size.height);
+            if (x0 < x1 && y0 < y1) {
+                hits ++;
+                if (15 == i) {
+                    minX = JMEMin(minX, x0); minY = JMEMin(minY, y0);
+                    maxX = JMEMax(maxX, x1); maxY = JMEMax(maxY, y1);
+                }
+            }
+        }
+    }
+    return hits == _geometryHits && minX < maxX &&
+    JMERectEqualToRect(_geometryUnion, JMERectMake(minX, minY, maxX - minX, maxY - minY));
+}
+
+/**
+ *  Run one case until all of its pixels are on the wire: inside a frame in
+ *  band mode, followed by a refresh in framebuffer mode, and until the last
+ *  queued block is out in async mode.
+ */
+static void _JMEST7735RBench_measure(const JMEST7735RBenchCase_t * benchCase)
+{
+#if JMEST7735R_USE_BANDRENDER
+    JMEST7735R_beginFrame(0x0000);
+#endif
+    benchCase->run();
+#if JMEST7735R_USE_BANDRENDER
+    JMEST7735R_endFrame();
+#endif
+#if JMEST7735R_USE_FRAMEBUFFER
+    JMEST7735R_refreshScreen();
+#endif
+    JMEST7735R_waitFence(JMEST7735R_fence());
+}
+
+/*********************************************************************
+ * CONSTANTS
+ */
+//
+// checked-in baselines of bytes, commands, window sets and CS cycles for the
+// direct, async, framebuffer and band render builds; a case fails when any
+// counter grows more than JMEST7735RBENCH_TOLERANCE percent over these values,
+// or when its check finds a wrong result
+static const JMEST7735RBenchCase_t _benchCases[] = {
+    {"fillScreen",           _JMEST7735RBench_fillScreen,       {{40971, 3, 2, 1},   {40971, 3, 2, 1},   {40971, 3, 2, 1},   {41205, 81, 41, 40}}},
+    {"drawLine.horizontal",  _JMEST7735RBench_lineHorizontal,   {{265, 3, 2, 1},     {265, 3, 2, 1},     {265, 3, 2, 1},     {41200, 80, 40, 40}}},
+    {"drawLine.vertical",    _JMEST7735RBench_lineVertical,     {{329, 3, 2, 1},     {329, 3, 2, 1},     {329, 3, 2, 1},     {41200, 80, 40, 40}}},
+    {"drawLine.shallow",     _JMEST7735RBench_lineShallow,      {{581, 93, 62, 31},  {581, 93, 62, 31},  {2518, 24, 16, 8},  {41200, 80, 40, 40}}},
+    {"drawLine.diagonal",    _JMEST7735RBench_lineDiagonal,     {{1300, 300, 200, 100}, {1300, 300, 200, 100}, {8888, 24, 16, 8},  {41200, 80, 40, 40}}},
+    {"drawLine.steep",       _JMEST7735RBench_lineSteep,        {{641, 93, 62, 31},  {641, 93, 62, 31},  {5332, 24, 16, 8},  {41200, 80, 40, 40}}},
+    {"drawRect.filled",      _JMEST7735RBench_rectFilled,       {{4811, 3, 2, 1},    {4811, 3, 2, 1},    {4811, 3, 2, 1},    {41200, 80, 40, 40}}},
+    {"drawRect.outline",     _JMEST7735RBench_rectOutline,      {{439, 11, 7, 4},    {439, 11, 7, 4},    {439, 11, 7, 4},    {41200, 80, 40, 40}}},
+    {"drawBitmap",           _JMEST7735RBench_bitmap,           {{2059, 3, 2, 1},    {2059, 3, 2, 1},    {2059, 3, 2, 1},    {41200, 80, 40, 40}}},
+    {"drawCompressedBitmap", _JMEST7735RBench_compressed,       {{2049, 1, 0, 1},    {2049, 1, 0, 1},    {2049, 1, 0, 1},    {41200, 80, 40, 40}}},
+    {"drawIndexedBitmap",    _JMEST7735RBench_indexed,          {{2049, 1, 0, 1},    {2049, 1, 0, 1},    {2049, 1, 0, 1},    {41200, 80, 40, 40}}},
+    {"drawBinaryImage",      _JMEST7735RBench_binaryImage,      {{2049, 1, 0, 1},    {2049, 1, 0, 1},    {2049, 1, 0, 1},    {41200, 80, 40, 40}}},
+    {"drawBinaryIcon",       _JMEST7735RBench_binaryIcon,       {{4658, 14, 9, 5},   {4658, 14, 9, 5},   {4619, 3, 2, 1},    {41200, 80, 40, 40}}},
+    {"drawMenuIcon",         _JMEST7735RBench_menuIcon,         {{4619, 3, 2, 1},    {4619, 3, 2, 1},    {4609, 1, 0, 1},    {41200, 80, 40, 40}}},
+    {"drawNumber",           _JMEST7735RBench_number,           {{983, 7, 4, 3},     {983, 7, 4, 3},     {971, 3, 2, 1},     {41200, 80, 40, 40}}},
+    {"drawString.size1",     _JMEST7735RBench_string1,          {{2891, 3, 2, 1},    {2891, 3, 2, 1},    {2891, 3, 2, 1},    {41200, 80, 40, 40}}},
+    {"drawString.size2",     _JMEST7735RBench_string2,          {{6155, 3, 2, 1},    {6155, 3, 2, 1},    {6155, 3, 2, 1},    {41200, 80, 40, 40}}},
+    {"drawString.size3",     _JMEST7735RBench_string3,          {{8651, 3, 2, 1},    {8651, 3, 2, 1},    {8651, 3, 2, 1},    {41200, 80, 40, 40}}},
+    {"drawString.size4",     _JMEST7735RBench_string4,          {{9227, 3, 2, 1},    {9227, 3, 2, 1},    {9227, 3, 2, 1},    {41200, 80, 40, 40}}},
+    {"drawText",             _JMEST7735RBench_text,             {{411, 3, 2, 1},     {411, 3, 2, 1},     {411, 3, 2, 1},     {41200, 80, 40, 40}}},
+    {"updateNumber",         _JMEST7735RBench_readout,          {{779, 3, 2, 1},     {779, 3, 2, 1},     {779, 3, 2, 1},     {41200, 80, 40, 40}}},
+    {"scroll.line",          _JMEST7735RBench_scrollLine,       {{2894, 4, 2, 2},    {2894, 4, 2, 2},    {2894, 4, 2, 2},    {41203, 81, 40, 41}}},
+    {"rotation.landscape",   _JMEST7735RBench_landscape,        {{2898, 6, 2, 4},    {2898, 6, 2, 4},    {40978, 6, 2, 4},   {41212, 84, 41, 43}}},
+    {"fillScreen.12bit",     _JMEST7735RBench_fillScreen12,     {{30735, 5, 2, 3},   {30735, 5, 2, 3},   {40965, 3, 0, 3},   {41204, 82, 40, 42}}},
+    {"drawString.12bit",     _JMEST7735RBench_string12,         {{2175, 5, 2, 3},    {2175, 5, 2, 3},    {2895, 5, 2, 3},    {41204, 82, 40, 42}}},
+    {"partial.status",       _JMEST7735RBench_partialStatus,    {{973, 5, 1, 3},     {973, 5, 1, 3},     {40978, 6, 2, 3},   {41207, 83, 40, 42}}},
+    {"drawBitmap.clipped",   _JMEST7735RBench_clippedBitmap,    {{1035, 3, 2, 1},    {1035, 3, 2, 1},    {1035, 3, 2, 1},    {41200, 80, 40, 40}}},
+    {"geometry.intersect",   _JMEST7735RBench_geometry,         {{0, 0, 0, 0},       {0, 0, 0, 0},       {0, 0, 0, 0},       {41200, 80, 40, 40}},
+                                                                _JMEST7735RBench_checkGeometry},
+};
+
+/*********************************************************************
+ * IMPLEMENT OF PUBLIC FUNCTIONS
+ */
+uint16_t JMEST7735RBench_run(FILE * out)
+{
+    uint16_t regressions = 0;
+    for (uint16_t i = 0; i < sizeof(_bitmap) / sizeof(_bitmap[0]); i ++) {
+        _bitmap[i] = (uint16_t)(i * 2654435761u >> 16);
+    }
+    for (uint16_t i = 0; i < sizeof(_binaryImage); i ++) {
+        _binaryImage[i] = (uint8_t)(i * 37 + 11);
+    }
+    for (uint16_t i = 0; i < sizeof(_indexedImage); i ++) {
+        _indexedImage[i] = (uint8_t)(i * 73 + 5);
+    }
+    for (uint16_t i = 0; i < sizeof(_palette) / sizeof(_palette[0]); i ++) {
+        _palette[i] = (uint16_t)(i * 0x1111);
+    }
+    for (uint16_t i = 0; i < sizeof(_rects) / sizeof(_rects[0]); i ++) {
+        _rects[i] = JMERectMake(i % 8 * 30, i / 8 * 22, 40 + i % 5 * 10, 24 + i % 3 * 8);
+    }
+    for (int16_t y = 0; y < 32; y ++) {
+        //
+        // flat colored icon: a disc on a plain background
+        for (int16_t x = 0; x < 32; x ++) {
+            int16_t dx = x - 16, dy = y - 16;
+            _flatIcon[y * 32 + x] = dx * dx + dy * dy < 144 ? 0xFD20 : 0x0000;
+        }
+    }
+    _JMEST7735RBench_encodeRLE(_flatIcon, 32 * 32, _flatIconRLE);
+
+    JMEST7735RSim_powerOn();
+    JMEST7735R_init();
+#if JMEST7735R_USE_FRAMEBUFFER
+    JMEST7735R_setFramebuffer(_framebuffer);
+    JMEST7735R_refreshScreen();
+#endif
+#if JMEST7735R_USE_GLYPHCACHE
+    JMEST7735R_setGlyphCache(_glyphArena, sizeof(_glyphArena));
+#endif
+    //
+    // a readout already on screen, only its last digit changes per call
+    _readout.origin = JMEPointMake(10, 40);
+    _readout.textColor = 0xFFFF;
+    _readout.bgColor = 0x0000;
+    _readout.fontSize = 2;
+    _readout.width = 7;
+    _readout.decimals = 2;
+    _readout.alignment = JMEST7735R_ALIGN_RIGHT;
+    JMEST7735RNumber_invalidate(&_readout);
+    JMEST7735R_updateNumber(&_readout, _readoutValue);
+    //
+    // whole screen scrollable, not scrolled until the scroll case
+    JMEST7735R_setScrollArea(0, 0);
+    fprintf(out, "case,bytes,commands,windowSets,csCycles,cdSwitches,usPerCall,status\n");
+    for (uint16_t n = 0; n < sizeof(_benchCases) / sizeof(_benchCases[0]); n ++) {
+        const JMEST7735RBenchCase_t * benchCase = &_benchCases[n];
+        const JMEST7735RBenchCost_t * baseline = &benchCase->baselines[JMEST7735RBENCH_CONFIG];
+        JMEST7735RSimStats_t stats;
+        clock_t start;
+        double usPerCall;
+        BOOL isRegressed, isWrong;
+
+        JMEST7735RSim_resetStats();
+        _JMEST7735RBench_measure(benchCase);
+        JMEST7735RSim_getStats(&stats);
+
+        start = clock();
+        for (uint16_t r = 0; r < JMEST7735RBENCH_REPEAT; r ++) {
+            _JMEST7735RBench_measure(benchCase);
+        }
+        usPerCall = (double)(clock() - start) * 1000000.0 / CLOCKS_PER_SEC / JMEST7735RBENCH_REPEAT;
+
+        isRegressed = stats.bytes * 100 > baseline->bytes * (100 + JMEST7735RBENCH_TOLERANCE) ||
+        stats.commands * 100 > baseline->commands * (100 + JMEST7735RBENCH_TOLERANCE) ||
+        stats.windowSets * 100 > baseline->windowSets * (100 + JMEST7735RBENCH_TOLERANCE) ||
+        stats.csCycles * 100 > baseline->csCycles * (100 + JMEST7735RBENCH_TOLERANCE);
+        isWrong = NULL != benchCase->check && !benchCase->check();
+        if (isRegressed || isWrong) {
+            regressions ++;
+        }
+        fprintf(out, "%s,%lu,%lu,%lu,%lu,%lu,%.2f,%s\n", benchCase->name,
+                (unsigned long)stats.bytes, (unsigned long)stats.commands,
+                (unsigned long)stats.windowSets, (unsigned long)stats.csCycles,
+                (unsigned long)stats.cdSwitches, usPerCall, isWrong ? "WRONG" : isRegressed ? "REGRESSED" : "ok");
+    }
+    return regressions;
+}
+
+#if defined(JMEST7735R_BENCH_MAIN)
+int main(void)
+{
+    uint16_t regressions = JMEST7735RBench_run(stdout);
+    if (regressions > 0) {
+        fprintf(stderr, "%u case(s) exceed the bus cost baseline\n", regressions);
+        return 1;
+    }
+    return 0;
+}
+#endif
+
+#endif /* defined(JMEST7735R_HOST_SIM) */
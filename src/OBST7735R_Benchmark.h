@@ -0,0 +1,38 @@
+/**
+ Filename:       OBST7735R_Benchmark.h
+ Revised:        $Date: 2015-06-18$
+ Revision:       $Revision: 01 $
+
+ Description:    This file contains the per-primitive bus cost benchmark of the
+                 ST7735R driver. It runs on the host simulator only.
+
+ Copyright 2015 ObornJung. All rights reserved.
+ */
+
+#ifndef __H__JMEST7735R_Benchmark__H__
+#define __H__JMEST7735R_Benchmark__H__
+
+/*********************************************************************
+ * INCLUDES
+ */
+#include <stdio.h>
+#include "JMEBase.h"
+
+/*********************************************************************
+ * MACROS
+ */
+#define JMEST7735RBENCH_REPEAT          50      ///< calls averaged for wall time
+#define JMEST7735RBENCH_TOLERANCE       10      ///< allowed growth over baseline, percent
+
+/*********************************************************************
+ * FUNCTIONS
+ */
+/**
+ *  Drive every public drawing call through the simulator, write one CSV
+ *  record per case to `out' and compare the bus counters with the checked-in
+ *  baselines. Returns the number of cases that regressed or computed a wrong
+ *  result.
+ */
+JME_EXTERN uint16_t JMEST7735RBench_run(FILE * out);
+
+#endif /* defined(__H__JMEST7735R_Benchmark__H__) */
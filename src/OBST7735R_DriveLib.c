@@ -14,6 +14,7 @@
 #include <string.h>
 #include "JMEBase.h"
 #include "JMEMath.h"
+#include "JMEDamageRegion.h"
 #include "JMERemoterRes.h"
 #include "JMEST7735R_Adapter.h"
 #include "JMEST7735R_DriveLib.h"
@@ -21,12 +22,172 @@
 /*********************************************************************
  * TYPEDEFS
  */
+#if JMEST7735R_USE_BANDRENDER
 typedef enum {
-    JMEST7735R_IPF_12        = 0x03,
-    JMEST7735R_IPF_16        = 0x05,
-    JMEST7735R_IPF_18        = 0x06,
-    JMEST7735R_IPF_NOUSED    = 0x07
-}JMEST7735R_IPF;
+    JMEST7735R_OP_LINE,
+    JMEST7735R_OP_RECT,
+    JMEST7735R_OP_BITMAP,
+    JMEST7735R_OP_BINARYIMAGE,
+    JMEST7735R_OP_BINARYICON,
+    JMEST7735R_OP_NUMBER,
+    JMEST7735R_OP_MENUICON,
+    JMEST7735R_OP_STRING,
+    JMEST7735R_OP_RLEBITMAP,
+    JMEST7735R_OP_INDEXEDBITMAP,
+    JMEST7735R_OP_TEXT,
+    JMEST7735R_OP_READOUT
+}JMEST7735R_OP;
+
+/**
+ *  One recorded draw call of a band rendered frame.
+ */
+typedef struct {
+    uint8_t             type;               ///< JMEST7735R_OP
+    uint8_t             param;              ///< fill, highlight, font size or text in a rect
+    JMERect             bounds;             ///< screen area touched by the call
+    JMERect             clip;               ///< clip in effect when the call was recorded
+    JMERect             frame;
+    JMEPoint            point;              ///< end point of a line
+    JMESize             size;               ///< image size of an icon
+    uint16_t            color;
+    uint16_t            bgColor;
+    uint16_t            number;
+    const void          * data;
+    const uint16_t      * palette;          ///< colors of an indexed bitmap
+    const JMEST7735RFont_t * font;          ///< font of proportional text
+}JMEST7735R_DrawOp_t;
+#endif
+
+//
+// host builds expand 1-bpp images eight pixels at a time with the compiler's
+// vector extensions (SSE2 or NEON); the target uses the nibble table alone
+#if defined(JMEST7735R_HOST_SIM) && defined(__GNUC__) && defined(__BYTE_ORDER__) && \
+    __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__ && (defined(__SSE2__) || defined(__ARM_NEON))
+#define JMEST7735R_USE_VECTOR           1
+typedef uint16_t JMEST7735R_Vector_t __attribute__((vector_size(16)));
+#else
+#define JMEST7735R_USE_VECTOR           0
+#endif
+
+/**
+ *  Two colors of a 1-bpp image, expanded once per draw call: every source
+ *  nibble to its four pixels in wire order.
+ */
+typedef struct {
+    uint16_t            fgColor;
+    uint16_t            bgColor;
+    uint8_t             nibble[16][8];
+#if JMEST7735R_USE_VECTOR
+    JMEST7735R_Vector_t fgLanes;            ///< foreground in all lanes, wire order
+    JMEST7735R_Vector_t bgLanes;
+#endif
+}JMEST7735R_MonoTable_t;
+
+/**
+ *  Pixels gathered in wire order for the open stream, pushed a block at a
+ *  time so glyph rows of consecutive characters share adapter calls.
+ */
+typedef struct {
+    uint8_t             fill;               ///< bytes used
+    uint8_t             bytes[JMEST7735R_MONO_BLOCK_PIXELS * 2];
+}JMEST7735R_PixelBlock_t;
+
+typedef enum {
+    JMEST7735R_FONT_ASCII8x12,
+    JMEST7735R_FONT_NUMBER5x8,
+    JMEST7735R_FONT_NONE        = 0xFF      ///< free glyph cache slot
+}JMEST7735R_FONT;
+
+#if JMEST7735R_USE_GLYPHCACHE
+
+/**
+ *  One glyph cache slot, JMEST7735R_GLYPH_SLOT_BYTES of the arena.
+ */
+typedef struct {
+    uint8_t             font;               ///< JMEST7735R_FONT
+    uint8_t             code;               ///< glyph index in the font
+    uint8_t             fontSize;
+    uint8_t             reserved;
+    uint16_t            fgColor;
+    uint16_t            bgColor;
+    uint16_t            lastUse;            ///< glyph clock of the last hit
+    uint8_t             pixels[JMEST7735R_GLYPH_SLOT_PIXELS * 2];   ///< wire order, row-major
+}JMEST7735R_Glyph_t;
+#endif
+
+/**
+ *  Display context: everything the driver knows about one panel. Functions
+ *  only touch the context they are given, so panels on different buses can
+ *  be driven from different threads.
+ */
+struct JMEST7735RDisplay {
+    const JMEST7735RAdapter_t * adapter;    ///< bus the panel is attached to
+    JMERect             frame;              ///< visible area in controller GRAM
+    JMERect             bounds;             ///< drawing coordinates, origin at the top-left pixel
+    JMERect             nativeFrame;        ///< visible area in controller GRAM at rotation 0
+    uint8_t             rotation;           ///< JMEST7735R_ROTATION
+    BOOL                isMirrored;         ///< left and right swapped
+    uint8_t             madctl;             ///< last programmed memory data access control
+    uint8_t             pixelFormat;        ///< last programmed JMEST7735R_IPF
+    BOOL                isColorHeld;        ///< 12-bit: `heldColor' waits for the second pixel of its pair
+    uint16_t            heldColor;
+    BOOL                isColumnValid;      ///< `column' matches the panel's CASET
+    BOOL                isRowValid;         ///< `row' matches the panel's RASET
+    uint8_t             column[4];          ///< last programmed column window
+    uint8_t             row[4];             ///< last programmed row window
+    uint8_t             partialTop;         ///< first row scanned in partial mode
+    uint8_t             partialHeight;      ///< rows scanned in partial mode, 0 in normal mode
+    BOOL                isIdle;             ///< 8-color idle mode
+    BOOL                isSleeping;         ///< sleep-in since JMEST7735RDisplay_enterSleep
+    JMERect             clip;               ///< drawing is cut to this part of the bounds
+    JMERect             clipStack[JMEST7735R_CLIP_DEPTH];   ///< clips saved by pushClip
+    uint8_t             clipDepth;
+    BOOL                isStreamClipped;    ///< the open pixel stream is wider or taller than its visible part
+    JMERect             sourceRect;         ///< frame of a clipped pixel stream
+    JMERect             visibleRect;        ///< part of `sourceRect' that is sent
+    int16_t             sourceX;            ///< position of a clipped pixel stream in `sourceRect'
+    int16_t             sourceY;
+    uint8_t             scrollTop;          ///< first row of the scroll area
+    uint8_t             scrollHeight;       ///< rows in the scroll area, 0 before one is set
+    uint8_t             scrollOffset;       ///< scroll area row shown at its top
+    JMERect             writeRect;          ///< rows of the memory write not given a window yet
+    uint16_t            segmentPixels;      ///< pixels left in the current window of a scrolled write
+#if JMEST7735R_USE_RAMTARGET
+    uint16_t            * target;           ///< RAM the pixel stream renders into, NULL streams to the panel
+    JMERect             targetRect;         ///< screen area covered by `target'
+    JMERect             streamRect;         ///< frame of the open pixel stream
+    uint16_t            streamX;            ///< write position of the open pixel stream
+    uint16_t            streamY;
+#endif
+#if JMEST7735R_USE_FRAMEBUFFER
+    uint16_t            * framebuffer;      ///< off-screen RGB565 buffer
+    JMEDamageRegion     damage;             ///< damaged region since the last refresh
+#endif
+#if JMEST7735R_USE_GLYPHCACHE
+    JMEST7735R_Glyph_t  * glyphs;           ///< cache slots in the caller's arena, NULL disables the cache
+    uint8_t             glyphCount;
+    uint16_t            glyphClock;         ///< advances on every cached glyph drawn
+#endif
+#if JMEST7735R_USE_BANDRENDER
+    BOOL                isRecording;        ///< draw calls are queued for JMEST7735R_endFrame
+    BOOL                isOverflowed;       ///< draw calls were dropped from the queue
+    uint8_t             opCount;
+    uint16_t            frameColor;         ///< background of the recorded frame
+    JMEST7735R_DrawOp_t ops[JMEST7735R_BAND_MAX_OPS];
+    uint16_t            band[JMEST7735RSCREENHEIGHT * JMEST7735R_BAND_HEIGHT];    ///< long side, a strip of any rotation fits
+#endif
+#if JMEST7735R_USE_ASYNC
+    uint8_t             line[2][JMEST7735R_ASYNC_LINE_BYTES];   ///< wire order RGB565 blocks
+    uint8_t             lineIndex;          ///< buffer being filled
+    uint16_t            lineCount;          ///< bytes in the buffer being filled
+    volatile BOOL       isInFlight;         ///< the other buffer is on the wire
+    volatile BOOL       isReleasePending;   ///< deselect the panel when the block completes
+    volatile JMEST7735RFence_t submitted;   ///< blocks handed to the adapter
+    volatile JMEST7735RFence_t completed;   ///< blocks the adapter finished
+    JMEST7735RCompletion_t callback;
+    void                * callbackContext;
+#endif
+};
 
 /*********************************************************************
  * CONSTANTS
@@ -35,17 +196,19 @@ const JMERect kJMEST7735RScreenFrame = {{0, 0}, {JMEST7735RSCREENWIDTH, JMEST773
 static const JMESize JMEST7735R_NUMBERSIZE = {5, 8};
 static const JMESize JMEST7735R_ASCIISIZE = {8, 12};
 
+//
+// 5x8 digits, one byte per row, leftmost pixel in bit 7
 static const uint8_t JMEASCII_NUMBER[] = {
-    0x3E, 0x51, 0x49, 0x45, 0x3E, // 0
-    0x00, 0x42, 0x7F, 0x40, 0x00, // 1
-    0x72, 0x49, 0x49, 0x49, 0x46, // 2
-    0x21, 0x41, 0x49, 0x4D, 0x33, // 3
-    0x18, 0x14, 0x12, 0x7F, 0x10, // 4
-    0x27, 0x45, 0x45, 0x45, 0x39, // 5
-    0x3C, 0x4A, 0x49, 0x49, 0x31, // 6
-    0x41, 0x21, 0x11, 0x09, 0x07, // 7
-    0x36, 0x49, 0x49, 0x49, 0x36, // 8
-    0x46, 0x49, 0x49, 0x29, 0x1E, // 9
+    0x70, 0x88, 0x98, 0xA8, 0xC8, 0x88, 0x70, 0x00, // 0
+    0x20, 0x60, 0x20, 0x20, 0x20, 0x20, 0x70, 0x00, // 1
+    0x70, 0x88, 0x08, 0x70, 0x80, 0x80, 0xF8, 0x00, // 2
+    0xF8, 0x08, 0x10, 0x30, 0x08, 0x88, 0x70, 0x00, // 3
+    0x10, 0x30, 0x50, 0x90, 0xF8, 0x10, 0x10, 0x00, // 4
+    0xF8, 0x80, 0xF0, 0x08, 0x08, 0x88, 0x70, 0x00, // 5
+    0x38, 0x40, 0x80, 0xF0, 0x88, 0x88, 0x70, 0x00, // 6
+    0xF8, 0x08, 0x08, 0x10, 0x20, 0x40, 0x80, 0x00, // 7
+    0x70, 0x88, 0x88, 0x70, 0x88, 0x88, 0x70, 0x00, // 8
+    0x70, 0x88, 0x88, 0x78, 0x08, 0x10, 0xE0, 0x00, // 9
 };
 
 /*********************************************************************
@@ -61,10 +224,16 @@ static const uint8_t JMEASCII_NUMBER[] = {
 #define JMEST7735R_NORON         0x13    ///< normal display mode on
 #define JMEST7735R_PTLON         0x12    ///< partial display mode on
 #define JMEST7735R_PTLAR         0x30    ///< partial area
+#define JMEST7735R_VSCRDEF       0x33    ///< vertical scrolling definition
+#define JMEST7735R_VSCSAD        0x37    ///< vertical scroll start address
 //
 // display inversion command
 #define JMEST7735R_INVOFF        0x20    ///< display inversion off
 #define JMEST7735R_INVON         0x21    ///< display inversion on
+//
+// idle mode command
+#define JMEST7735R_IDMOFF        0x38    ///< idle mode off
+#define JMEST7735R_IDMON         0x39    ///< idle mode on, 8 colors
 
 #define JMEST7735R_DISPOFF       0x28    ///< display off
 #define JMEST7735R_DISPON        0x29    ///< display on
@@ -76,6 +245,9 @@ static const uint8_t JMEASCII_NUMBER[] = {
 #define JMEST7735R_RGBSET        0x2D    ///< color setting for 4K,65k and 262k ?????
 
 #define JMEST7735R_MADCTL        0x36    ///< memory data access control
+#define JMEST7735R_MADCTL_MY     0x80    ///< row address order
+#define JMEST7735R_MADCTL_MX     0x40    ///< column address order
+#define JMEST7735R_MADCTL_MV     0x20    ///< row/column exchange
 #define JMEST7735R_COLMOD        0x3A    ///< interface pixel format
 //
 // panel function control command
@@ -97,602 +269,2969 @@ static const uint8_t JMEASCII_NUMBER[] = {
 
 #define JMEST7735R_EXTCTRL       0xF0    ///< Extension Command Control
 
-#define JMEST7735R_seqWrite(byte)  JMEST7735R_RWCLR(); JMEST7735R_writeByte((byte)); JMEST7735R_RWSET();
+#define JMEST7735R_SEQ_DELAY     0x80    ///< init sequence: a delay follows the parameters
+//
+// hardware reset timing: the reset pulse needs 10us, the controller is ready
+// for commands 5ms after release and for sleep out after 120ms
+#define JMEST7735R_RESET_PULSE_MS       1
+#define JMEST7735R_RESET_SETTLE_MS      120
 
-/*********************************************************************
- * LOCAL FUNCTIONS
- */
-#pragma mark - inner methods
-static inline void _JMEST7735R_HDReset(void);
-static inline void _JMEST7735R_SWReset(void);
-static inline uint8_t _JMEST7735R_read_data(void);
-static inline void _JMEST7735R_write_data(uint8_t data);
-static inline void _JMEST7735R_write_command(uint8_t cmd);
-static inline void _JMEST7735R_setPixelFormat(JMEST7735R_IPF pixelFormat);
-static inline BOOL _JMEST7735R_setDrawWindow(JMERect rect);
-static inline void _JJMEST7735R_drawPixel(uint8_t x, uint8_t y, uint16_t color);
-static inline void _JMEST7735R_writePixelData(const uint16_t * colorArray, uint16_t count);
+//
+// cost of opening one more window (CASET, RASET and RAMWR: 11 bytes plus
+// chip select cycles) expressed in RGB565 pixels
+#define JMEST7735R_WINDOW_SETUP_PIXELS  8
+
+#define JMEST7735R_DEFAULT_DISPLAY      (&_displays[0])
+//
+// pixels packed per adapter writeBlock call when sending an RGB565 array
+#define JMEST7735R_BLOCK_PIXELS         16
+//
+// 3-byte units (one 18-bit pixel or two 12-bit pixels) packed per writeBlock
+#define JMEST7735R_PACK_BLOCK_UNITS     32
+//
+// background spans of text at least this long leave as a fill instead of
+// being copied into the pixel block
+#define JMEST7735R_FILL_SPAN_PIXELS     8
+//
+// glyphs of one text run whose glyph cache slot is looked up once per run
+#define JMEST7735R_RUN_CACHED_GLYPHS    16
 
 /*********************************************************************
- * IMPLEMENT OF PUBLIC FUNCTIONS
+ * INIT SEQUENCES
  */
-#pragma mark - JMEST7735R control function
-void JMEST7735R_init(void)
-{
-    //
-    // device port init
-    JMEST7735R_portInit();
+//
+// init sequences: command, parameter count (JMEST7735R_SEQ_DELAY set when a
+// delay in ms follows the parameters), parameters[, delay]
+static const uint8_t kJMEST7735RPanelSequence[] = {
     //
-    // hardware reset
-    _JMEST7735R_HDReset();
-    //    //
-    //    // software reset
-    //    _JMEST7735R_SWReset();
+    // leave sleep-in after reset, the supply settles for 120 ms
+    JMEST7735R_SLOUT,   JMEST7735R_SEQ_DELAY | 0, 120,
     //
-    // init frame rate
-    _JMEST7735R_write_command(JMEST7735R_FRMCTR1);
-    _JMEST7735R_write_data(0x02); _JMEST7735R_write_data(0x35); _JMEST7735R_write_data(0x36);
-    _JMEST7735R_write_command(JMEST7735R_FRMCTR2);
-    _JMEST7735R_write_data(0x02); _JMEST7735R_write_data(0x35); _JMEST7735R_write_data(0x36);
-    _JMEST7735R_write_command(JMEST7735R_FRMCTR3);
-    _JMEST7735R_write_data(0x02); _JMEST7735R_write_data(0x35); _JMEST7735R_write_data(0x36);
-    _JMEST7735R_write_data(0x02); _JMEST7735R_write_data(0x35); _JMEST7735R_write_data(0x36);
+    // frame rate
+    JMEST7735R_FRMCTR1, 3, 0x02, 0x35, 0x36,
+    JMEST7735R_FRMCTR2, 3, 0x02, 0x35, 0x36,
+    JMEST7735R_FRMCTR3, 6, 0x02, 0x35, 0x36, 0x02, 0x35, 0x36,
     //
-    // init dispaly inversion control
-    _JMEST7735R_write_command(JMEST7735R_INVCTR);
-    _JMEST7735R_write_data(0x03);
+    // dispaly inversion control
+    JMEST7735R_INVCTR,  1, 0x03,
     //
-    // init power sequence
-    _JMEST7735R_write_command(JMEST7735R_PWCTR1);
-    _JMEST7735R_write_data(0xA2); _JMEST7735R_write_data(0x02); _JMEST7735R_write_data(0x84);
-    _JMEST7735R_write_command(JMEST7735R_PWCTR2);
-    _JMEST7735R_write_data(0xC5);
-    _JMEST7735R_write_command(JMEST7735R_PWCTR3);
-    _JMEST7735R_write_data(0x0D); _JMEST7735R_write_data(0x00);
-    _JMEST7735R_write_command(JMEST7735R_PWCTR4);
-    _JMEST7735R_write_data(0x8A); _JMEST7735R_write_data(0x2A);
-    _JMEST7735R_write_command(JMEST7735R_PWCTR5);
-    _JMEST7735R_write_data(0x8A); _JMEST7735R_write_data(0xEE);
-    _JMEST7735R_write_command(JMEST7735R_VMCTR1);  ///< VCOM
-    _JMEST7735R_write_data(0X03);
+    // power sequence
+    JMEST7735R_PWCTR1,  3, 0xA2, 0x02, 0x84,
+    JMEST7735R_PWCTR2,  1, 0xC5,
+    JMEST7735R_PWCTR3,  2, 0x0D, 0x00,
+    JMEST7735R_PWCTR4,  2, 0x8A, 0x2A,
+    JMEST7735R_PWCTR5,  2, 0x8A, 0xEE,
+    JMEST7735R_VMCTR1,  1, 0x03,
     //
     // gamma correction
-    _JMEST7735R_write_command(JMEST7735R_GMCTRP1);
-    _JMEST7735R_write_data(0x12); _JMEST7735R_write_data(0x1c);
-    _JMEST7735R_write_data(0x10); _JMEST7735R_write_data(0x18);
-    _JMEST7735R_write_data(0x33); _JMEST7735R_write_data(0x2C);
-    _JMEST7735R_write_data(0x25); _JMEST7735R_write_data(0x28);
-    _JMEST7735R_write_data(0x28); _JMEST7735R_write_data(0x27);
-    _JMEST7735R_write_data(0x2f); _JMEST7735R_write_data(0x3C);
-    _JMEST7735R_write_data(0x00); _JMEST7735R_write_data(0x03);
-    _JMEST7735R_write_data(0x03); _JMEST7735R_write_data(0x10);
-    _JMEST7735R_write_command(JMEST7735R_GMCTRN1);
-    _JMEST7735R_write_data(0x12); _JMEST7735R_write_data(0x1d);
-    _JMEST7735R_write_data(0x10); _JMEST7735R_write_data(0x18);
-    _JMEST7735R_write_data(0x2d); _JMEST7735R_write_data(0x28);
-    _JMEST7735R_write_data(0x23); _JMEST7735R_write_data(0x28);
-    _JMEST7735R_write_data(0x28); _JMEST7735R_write_data(0x26);
-    _JMEST7735R_write_data(0x2f); _JMEST7735R_write_data(0x3B);
-    _JMEST7735R_write_data(0x00); _JMEST7735R_write_data(0x03);
-    _JMEST7735R_write_data(0x03); _JMEST7735R_write_data(0x10);
+    JMEST7735R_GMCTRP1, 16, 0x12, 0x1c, 0x10, 0x18, 0x33, 0x2C, 0x25, 0x28,
+                            0x28, 0x27, 0x2f, 0x3C, 0x00, 0x03, 0x03, 0x10,
+    JMEST7735R_GMCTRN1, 16, 0x12, 0x1d, 0x10, 0x18, 0x2d, 0x28, 0x23, 0x28,
+                            0x28, 0x26, 0x2f, 0x3B, 0x00, 0x03, 0x03, 0x10,
+};
+
+//
+// address order per JMEST7735R_ROTATION, the panel is mounted for MX|MY
+static const uint8_t kJMEST7735RRotationMADCTL[] = {
+    JMEST7735R_MADCTL_MX | JMEST7735R_MADCTL_MY,
+    JMEST7735R_MADCTL_MY | JMEST7735R_MADCTL_MV,
+    0,
+    JMEST7735R_MADCTL_MX | JMEST7735R_MADCTL_MV,
+};
+
+static const uint8_t kJMEST7735RModeSequence[] = {
     //
-    // init memory data access control:MX, MY, RGB mode
-    _JMEST7735R_write_command(JMEST7735R_MADCTL);
-    _JMEST7735R_write_data(0xC8);
+    // memory data access control:MX, MY, RGB mode
+    JMEST7735R_MADCTL,  1, 0xC8,
     //
-    // set interface pixel format:65k mode
-    _JMEST7735R_setPixelFormat(JMEST7735R_IPF_16);
+    // interface pixel format:65k mode
+    JMEST7735R_COLMOD,  1, JMEST7735R_IPF_16,
     //
     // display on
-    _JMEST7735R_write_command(JMEST7735R_DISPON);
+    JMEST7735R_DISPON,  0,
+    JMEST7735R_EXTCTRL, 1, 0x01,
+    0xF6,               1, 0x00,
+};
 
-    _JMEST7735R_write_command(JMEST7735R_EXTCTRL);
-    _JMEST7735R_write_data(0x01);
-    _JMEST7735R_write_command(0xF6);
-    _JMEST7735R_write_data(0x00);
-}
+/*********************************************************************
+ * LOCAL VARIABLES
+ */
+static JMEST7735RDisplay_t _displays[JMEST7735R_MAX_DISPLAYS] = {
+    {&kJMEST7735RDefaultAdapter,
+     {{0, 0}, {JMEST7735RSCREENWIDTH, JMEST7735RSCREENHEIGHT}},
+     {{0, 0}, {JMEST7735RSCREENWIDTH, JMEST7735RSCREENHEIGHT}},
+     {{0, 0}, {JMEST7735RSCREENWIDTH, JMEST7735RSCREENHEIGHT}}}
+};
+static uint8_t _displayCount = 1;       ///< slot 0 is the display of the JMEST7735R_* functions
 
-void JMEST7735R_enterSleep(void)
+/*********************************************************************
+ * LOCAL FUNCTIONS
+ */
+#pragma mark - inner methods
+static inline void _JMEST7735R_HDReset(JMEST7735RDisplay_t * display);
+static inline void _JMEST7735R_SWReset(JMEST7735RDisplay_t * display);
+static inline uint8_t _JMEST7735R_read_data(JMEST7735RDisplay_t * display);
+static inline void _JMEST7735R_beginTransaction(JMEST7735RDisplay_t * display);
+static inline void _JMEST7735R_endTransaction(JMEST7735RDisplay_t * display);
+static inline void _JMEST7735R_write_data(JMEST7735RDisplay_t * display, uint8_t data);
+static inline void _JMEST7735R_write_params(JMEST7735RDisplay_t * display, const uint8_t * params, uint8_t count);
+static inline void _JMEST7735R_write_command(JMEST7735RDisplay_t * display, uint8_t cmd);
+static void _JMEST7735R_writeCommandGroup(JMEST7735RDisplay_t * display, uint8_t cmd, const uint8_t * params, uint8_t count);
+static inline void _JMEST7735R_delay(JMEST7735RDisplay_t * display, uint16_t ms);
+static inline void _JMEST7735R_setPixelFormat(JMEST7735RDisplay_t * display, JMEST7735R_IPF pixelFormat);
+static inline void _JMEST7735R_invalidateWindow(JMEST7735RDisplay_t * display);
+static void _JMEST7735R_runSequence(JMEST7735RDisplay_t * display, const uint8_t * sequence, uint16_t length);
+static inline BOOL _JMEST7735R_setDrawWindow(JMEST7735RDisplay_t * display, JMERect rect);
+static void _JMEST7735R_fillSpan(JMEST7735RDisplay_t * display, int16_t x, int16_t y, int16_t width, int16_t height, uint16_t color);
+static void _JMEST7735R_rasterLine(JMEST7735RDisplay_t * display, JMEPoint start, JMEPoint end, uint8_t thickness, uint16_t color);
+static inline BOOL _JMEST7735R_beginMemoryWrite(JMEST7735RDisplay_t * display, JMERect rect);
+static void _JMEST7735R_openSegment(JMEST7735RDisplay_t * display);
+static inline uint16_t _JMEST7735R_segmentSpan(JMEST7735RDisplay_t * display, uint16_t count);
+static void _JMEST7735R_writeScrollStart(JMEST7735RDisplay_t * display);
+static void _JMEST7735R_writeRotation(JMEST7735RDisplay_t * display);
+static inline BOOL _JMEST7735R_isScanned(JMEST7735RDisplay_t * display, JMERect rect);
+static inline JMERect _JMEST7735R_scannedRect(JMEST7735RDisplay_t * display, JMERect rect);
+static inline void _JMEST7735R_writeColor(JMEST7735RDisplay_t * display, uint16_t color, uint16_t count);
+static inline void _JMEST7735R_writePixelData(JMEST7735RDisplay_t * display, const uint16_t * colorArray, uint16_t count);
+static inline void _JMEST7735R_writePixelBytes(JMEST7735RDisplay_t * display, const uint8_t * bytes, uint16_t count);
+static inline void _JMEST7735R_endMemoryWrite(JMEST7735RDisplay_t * display);
+static inline void _JMEST7735R_pack12(uint16_t first, uint16_t second, uint8_t * out);
+static inline void _JMEST7735R_pack18(uint16_t color, uint8_t * out);
+static void _JMEST7735R_writePacked(JMEST7735RDisplay_t * display, const uint8_t * bytes, uint16_t length);
+static void _JMEST7735R_packColor(JMEST7735RDisplay_t * display, uint16_t color, uint16_t count);
+static void _JMEST7735R_packPixelData(JMEST7735RDisplay_t * display, const uint16_t * colorArray, uint16_t count);
+static void _JMEST7735R_packPixelBytes(JMEST7735RDisplay_t * display, const uint8_t * bytes, uint16_t count);
+static void _JMEST7735R_releaseHeldColor(JMEST7735RDisplay_t * display);
+#if JMEST7735R_USE_ASYNC
+static inline void _JMEST7735R_waitTransfer(JMEST7735RDisplay_t * display);
+static inline void _JMEST7735R_queuePixel(JMEST7735RDisplay_t * display, uint16_t color);
+static void _JMEST7735R_submitLine(JMEST7735RDisplay_t * display, BOOL isLast);
+#endif
+static JMERect _JMEST7735R_visibleRect(JMEST7735RDisplay_t * display, JMERect rect);
+static uint16_t _JMEST7735R_clipRun(JMEST7735RDisplay_t * display, uint16_t count, uint16_t * skip, uint16_t * send);
+static BOOL _JMEST7735R_beginPixels(JMEST7735RDisplay_t * display, JMERect rect);
+static void _JMEST7735R_pushColor(JMEST7735RDisplay_t * display, uint16_t color, uint16_t count);
+static void _JMEST7735R_pushPixels(JMEST7735RDisplay_t * display, const uint16_t * colorArray, uint16_t count);
+static void _JMEST7735R_pushPixelBytes(JMEST7735RDisplay_t * display, const uint8_t * bytes, uint16_t count);
+static void _JMEST7735R_sendColor(JMEST7735RDisplay_t * display, uint16_t color, uint16_t count);
+static void _JMEST7735R_sendPixels(JMEST7735RDisplay_t * display, const uint16_t * colorArray, uint16_t count);
+static void _JMEST7735R_sendPixelBytes(JMEST7735RDisplay_t * display, const uint8_t * bytes, uint16_t count);
+static void _JMEST7735R_endPixels(JMEST7735RDisplay_t * display);
+static JMERect _JMEST7735R_cropStream(JMEST7735RDisplay_t * display);
+static void _JMEST7735R_buildMonoTable(JMEST7735R_MonoTable_t * table, uint16_t fgColor, uint16_t bgColor);
+static inline void _JMEST7735R_expandByte(const JMEST7735R_MonoTable_t * table, uint8_t data, uint8_t count, uint8_t * out);
+static void _JMEST7735R_pushMono(JMEST7735RDisplay_t * display, const JMEST7735R_MonoTable_t * table, const uint8_t * image,
+                                 uint8_t column, uint16_t stride, uint8_t width, uint8_t height, uint8_t scale);
+static void _JMEST7735R_drawGlyph(JMEST7735RDisplay_t * display, const JMEST7735R_MonoTable_t * table, JMERect frame,
+                                  uint8_t font, uint8_t code, const uint8_t * image, JMESize size, uint8_t fontSize);
+static void _JMEST7735R_flushBlock(JMEST7735RDisplay_t * display, JMEST7735R_PixelBlock_t * block);
+static void _JMEST7735R_blockFill(JMEST7735RDisplay_t * display, JMEST7735R_PixelBlock_t * block,
+                                  const JMEST7735R_MonoTable_t * table, uint16_t count);
+static void _JMEST7735R_blockMono(JMEST7735RDisplay_t * display, JMEST7735R_PixelBlock_t * block, const JMEST7735R_MonoTable_t * table,
+                                  const uint8_t * source, uint16_t from, uint16_t to, uint8_t scale);
+static BOOL _JMEST7735R_fontGlyph(const JMEST7735RFont_t * font, char character, JMEST7735RFontGlyph_t * glyph);
+static void _JMEST7735R_drawTextRun(JMEST7735RDisplay_t * display, const JMEST7735R_MonoTable_t * table, const JMEST7735RFont_t * font,
+                                    const char * string, uint16_t length, int16_t x, int16_t y, JMERect clip, uint8_t scale);
+static void _JMEST7735R_blockGlyphRow(JMEST7735RDisplay_t * display, JMEST7735R_PixelBlock_t * block, const JMEST7735R_MonoTable_t * table,
+                                      const uint8_t * atlas, const JMEST7735RFontGlyph_t * glyph, uint8_t row,
+                                      uint16_t from, uint16_t to, uint8_t scale);
+static uint8_t _JMEST7735R_formatNumber(const JMEST7735RNumber_t * number, int32_t value, char * text);
+static JMERect _JMEST7735R_numberField(const JMEST7735RNumber_t * number, const char * text, int16_t * textX);
+static void _JMEST7735R_drawNumberField(JMEST7735RDisplay_t * display, JMEST7735RNumber_t * number, const char * text, BOOL isRepaint);
+#if JMEST7735R_USE_GLYPHCACHE
+static void _JMEST7735R_blockBytes(JMEST7735RDisplay_t * display, JMEST7735R_PixelBlock_t * block, const uint8_t * bytes, uint16_t count);
+static void _JMEST7735R_expandMono(const JMEST7735R_MonoTable_t * table, const uint8_t * image,
+                                   uint8_t width, uint8_t height, uint8_t scale, uint8_t * out);
+static JMEST7735R_Glyph_t * _JMEST7735R_cachedGlyph(JMEST7735RDisplay_t * display, const JMEST7735R_MonoTable_t * table,
+                                                    uint8_t font, uint8_t code, const uint8_t * image, JMESize size, uint8_t fontSize);
+#endif
+#if JMEST7735R_USE_RAMTARGET
+static inline void _JMEST7735R_storePixel(JMEST7735RDisplay_t * display, uint16_t color);
+#endif
+#if JMEST7735R_USE_FRAMEBUFFER
+static void _JMEST7735R_invalidate(JMEST7735RDisplay_t * display, JMERect rect);
+static void _JMEST7735R_flushFramebuffer(JMEST7735RDisplay_t * display, JMERect rect);
+static void _JMEST7735R_reversePixels(uint16_t * pixels, uint16_t count);
+#endif
+#if JMEST7735R_USE_BANDRENDER
+static BOOL _JMEST7735R_recordOp(JMEST7735RDisplay_t * display, const JMEST7735R_DrawOp_t * op);
+static void _JMEST7735R_replayOp(JMEST7735RDisplay_t * display, const JMEST7735R_DrawOp_t * op);
+#endif
+
+/*********************************************************************
+ * IMPLEMENT OF PUBLIC FUNCTIONS
+ */
+#pragma mark - display context
+JMEST7735RDisplay_t * JMEST7735RDisplay_default(void)
 {
-    JMEST7735R_LEDOFF();
-    _JMEST7735R_write_command(JMEST7735R_SLPIN);
-    JMEST7735R_delayMS(20);
-    JMEST7735R_IOEnterSleep(TRUE);
+    return JMEST7735R_DEFAULT_DISPLAY;
 }
 
-void JMEST7735R_exitSleep(void)
+JMEST7735RDisplay_t * JMEST7735RDisplay_create(const JMEST7735RAdapter_t * adapter, JMERect frame)
 {
-    JMEST7735R_IOEnterSleep(FALSE);
-    JMEST7735R_LEDON();
-    _JMEST7735R_write_command(JMEST7735R_SLOUT);
-    JMEST7735R_delayMS(20);
+    JMEST7735RDisplay_t * display;
+    if (_displayCount >= JMEST7735R_MAX_DISPLAYS || NULL == adapter ||
+        JMERectIsEmpty(frame) || frame.size.width > JMEST7735RSCREENWIDTH || frame.size.height > JMEST7735RSCREENHEIGHT) {
+        return NULL;
+    }
+    display = &_displays[_displayCount ++];
+    memset(display, 0, sizeof(*display));
+    display->adapter = adapter;
+    display->frame = frame;
+    display->bounds = JMERectMake(0, 0, frame.size.width, frame.size.height);
+    display->nativeFrame = frame;
+    display->clip = display->bounds;
+    return display;
 }
 
-#pragma mark - drawing function
-void JMEST7735R_refreshScreen(void)
+#pragma mark - JMEST7735R control function
+void JMEST7735RDisplay_setAdapter(JMEST7735RDisplay_t * display, const JMEST7735RAdapter_t * adapter)
 {
-    _JMEST7735R_write_command(0x00);
+#if JMEST7735R_USE_ASYNC
+    _JMEST7735R_waitTransfer(display);
+#endif
+    display->adapter = NULL != adapter ? adapter : &kJMEST7735RDefaultAdapter;
+    _JMEST7735R_invalidateWindow(display);
 }
 
-void JMEST7735R_drawLine(JMEPoint start, JMEPoint end, uint16_t color)
+void JMEST7735RDisplay_init(JMEST7735RDisplay_t * display)
 {
-    uint8_t x0 = start.x < end.x ? start.x : end.x;
-    uint8_t y0 = start.y < end.y ? start.y : end.y;
-    uint8_t x1 = start.x < end.x ? end.x : start.x;
-    uint8_t y1 = start.y < end.y ? end.y : start.y;
-    uint8_t length = 0;
+    //
+    // hardware reset
+    _JMEST7735R_HDReset(display);
+    display->rotation = JMEST7735R_ROTATION_0;
+    display->isMirrored = FALSE;
+    display->frame = display->nativeFrame;
+    display->bounds = JMERectMake(0, 0, display->frame.size.width, display->frame.size.height);
+    display->clip = display->bounds;
+    display->clipDepth = 0;
+    display->partialHeight = 0;
+    display->isIdle = FALSE;
+    display->isSleeping = FALSE;
+    display->scrollTop = 0;
+    display->scrollHeight = 0;
+    display->scrollOffset = 0;
+    //    //
+    //    // software reset
+    //    _JMEST7735R_SWReset(display);
+    //
+    // panel programming, then display mode
+    _JMEST7735R_runSequence(display, kJMEST7735RPanelSequence, sizeof(kJMEST7735RPanelSequence));
+    _JMEST7735R_runSequence(display, kJMEST7735RModeSequence, sizeof(kJMEST7735RModeSequence));
+}
 
-    if (x0 == x1)
-    {
-        length = y1 - y0;
-        if (length > 0)
-        {
-            _JMEST7735R_setDrawWindow(JMERectMake(x0, y0, 1, length));
-            _JMEST7735R_write_command(JMEST7735R_RAMWR);
-            JMEST7735R_CDSET();
-            JMEST7735R_RDSET();
-            JMEST7735R_CSCLR();
-            while (length --)
-            {
-                JMEST7735R_seqWrite((uint8_t)(color >> 8));
-                JMEST7735R_seqWrite((uint8_t)color);
-            }
-            JMEST7735R_CSSET();
-        }
-    }
-    else if (y0 == y1)
-    {
-        length = x1 - x0;
-        if (length > 0)
-        {
-            _JMEST7735R_setDrawWindow(JMERectMake(x0, y0, length, 1));
-            _JMEST7735R_write_command(JMEST7735R_RAMWR);
-            JMEST7735R_CDSET();
-            JMEST7735R_RDSET();
-            JMEST7735R_CSCLR();
-            while (length --)
-            {
-                JMEST7735R_seqWrite((uint8_t)(color >> 8));
-                JMEST7735R_seqWrite((uint8_t)color);
-            }
-            JMEST7735R_CSSET();
-        }
-    }
-    else
-    {
-        uint8_t dx = x1 - x0;
-        uint8_t dy = y1 - y0;
-        if (dx > dy)
-        {
-            float scale = dy/dx;
-            while (dx --)
-            {
-                _JJMEST7735R_drawPixel(x0 + dx, y0 + dx * scale, color);
-            }
-        }
-        else
-        {
-            float scale = dx/dy;
-            while (dy --)
-            {
-                _JJMEST7735R_drawPixel(x0 + dy * scale, y0 + dy, color);
-            }
-        }
+void JMEST7735RDisplay_resume(JMEST7735RDisplay_t * display)
+{
+    //
+    // the controller kept power, gamma and frame rate settings; only the
+    // display mode is restored, after waking it from JMEST7735RDisplay_enterSleep
+    JMEST7735R_IPF pixelFormat = display->pixelFormat;
+    if (display->isSleeping) {
+        JMEST7735RDisplay_exitSleep(display);
     }
+    _JMEST7735R_invalidateWindow(display);
+    _JMEST7735R_runSequence(display, kJMEST7735RModeSequence, sizeof(kJMEST7735RModeSequence));
+    _JMEST7735R_writeRotation(display);
+    JMEST7735RDisplay_setPixelFormat(display, pixelFormat);
 }
 
-void JMEST7735R_drawRect(JMERect frame, uint16_t color, BOOL fill) {
-    if (_JMEST7735R_setDrawWindow(frame)) {
-        if (fill) {
-            uint16_t pixelCount = frame.size.width * frame.size.height;
-            _JMEST7735R_write_command(JMEST7735R_RAMWR);
-            JMEST7735R_CDSET();
-            JMEST7735R_RDSET();
-            JMEST7735R_CSCLR();
-            while (pixelCount --)
-            {
-                JMEST7735R_seqWrite((uint8_t)(color >> 8));
-                JMEST7735R_seqWrite((uint8_t)color);
-            }
-            JMEST7735R_CSSET();
-        } else {
-            JMEPoint start = frame.origin;
-            JMEPoint end;
-            //  ___
-            //
-            end.x = frame.origin.x + frame.size.width; end.y = frame.origin.y;
-            JMEST7735R_drawLine(start, end, color);
-            //  ___
-            //     |
-            end.x -= 1;
-            start.x = end.x; start.y = frame.origin.y + frame.size.height;
-            JMEST7735R_drawLine(end, start, color);
-            //  ___
-            //  ___|
-            start.x += 1; start.y -= 1;
-            end.x = frame.origin.x; end.y = start.y;
-            JMEST7735R_drawLine(end, start, color);
-            //  ___
-            // |___|
-            start = frame.origin; end.y += 1;
-            JMEST7735R_drawLine(start, end, color);
-        }
+void JMEST7735RDisplay_enterSleep(JMEST7735RDisplay_t * display)
+{
+    if (NULL != display->adapter->setBacklight) {
+        display->adapter->setBacklight(display->adapter->context, FALSE);
     }
+    _JMEST7735R_writeCommandGroup(display, JMEST7735R_SLPIN, NULL, 0);
+    _JMEST7735R_invalidateWindow(display);
+    display->isSleeping = TRUE;
+    _JMEST7735R_delay(display, 20);
 }
 
-void JMEST7735R_fillScreen(uint16_t color)
+void JMEST7735RDisplay_exitSleep(JMEST7735RDisplay_t * display)
 {
-    JMEST7735R_drawRect(JMERectMake(0, 0, kJMEST7735RScreenFrame.size.width, kJMEST7735RScreenFrame.size.height), color, TRUE);
+    if (NULL != display->adapter->setBacklight) {
+        display->adapter->setBacklight(display->adapter->context, TRUE);
+    }
+    _JMEST7735R_writeCommandGroup(display, JMEST7735R_SLOUT, NULL, 0);
+    _JMEST7735R_invalidateWindow(display);
+    display->isSleeping = FALSE;
+    _JMEST7735R_delay(display, 20);
 }
 
-void JMEST7735R_drawBitmap(const uint16_t * image, JMERect frame, BOOL isHighLight) {
-    if (NULL != image) {
-        if (_JMEST7735R_setDrawWindow(frame)) {
-            _JMEST7735R_writePixelData(image, frame.size.width * frame.size.height);
-        }
-    }
-}
-
-void JMEST7735R_drawBinaryImage(const uint8_t * image, JMERect frame, uint16_t fgColor, uint16_t bgColor) {
-    if (_JMEST7735R_setDrawWindow(frame)) {
-        uint16_t pixelCount = frame.size.width * frame.size.height >> 3;
-        _JMEST7735R_write_command(JMEST7735R_RAMWR);
-        JMEST7735R_CDSET();
-        JMEST7735R_RDSET();
-        JMEST7735R_CSCLR();
-        for (uint16_t n = 0; n < pixelCount; n ++) {
-            uint8_t imageData = image[n];
-//            for (int8_t i = 7; i > -1; i --) {
-//                if (imageData & JMEBit(i)) {
-//                    JMEST7735R_seqWrite((uint8_t)(fgColor >> 8));
-//                    JMEST7735R_seqWrite((uint8_t)fgColor);
-//                } else {
-//                    JMEST7735R_seqWrite((uint8_t)(bgColor >> 8));
-//                    JMEST7735R_seqWrite((uint8_t)bgColor);
-//                }
-//            }
-            if (imageData & JMEBit(7)) {
-                JMEST7735R_seqWrite((uint8_t)(fgColor >> 8));
-                JMEST7735R_seqWrite((uint8_t)fgColor);
-            } else {
-                JMEST7735R_seqWrite((uint8_t)(bgColor >> 8));
-                JMEST7735R_seqWrite((uint8_t)bgColor);
-            }
-            if (imageData & JMEBit(6)) {
-                JMEST7735R_seqWrite((uint8_t)(fgColor >> 8));
-                JMEST7735R_seqWrite((uint8_t)fgColor);
-            } else {
-                JMEST7735R_seqWrite((uint8_t)(bgColor >> 8));
-                JMEST7735R_seqWrite((uint8_t)bgColor);
-            }
-            if (imageData & JMEBit(5)) {
-                JMEST7735R_seqWrite((uint8_t)(fgColor >> 8));
-                JMEST7735R_seqWrite((uint8_t)fgColor);
-            } else {
-                JMEST7735R_seqWrite((uint8_t)(bgColor >> 8));
-                JMEST7735R_seqWrite((uint8_t)bgColor);
-            }
-            if (imageData & JMEBit(4)) {
-                JMEST7735R_seqWrite((uint8_t)(fgColor >> 8));
-                JMEST7735R_seqWrite((uint8_t)fgColor);
-            } else {
-                JMEST7735R_seqWrite((uint8_t)(bgColor >> 8));
-                JMEST7735R_seqWrite((uint8_t)bgColor);
-            }
-            if (imageData & JMEBit(3)) {
-                JMEST7735R_seqWrite((uint8_t)(fgColor >> 8));
-                JMEST7735R_seqWrite((uint8_t)fgColor);
-            } else {
-                JMEST7735R_seqWrite((uint8_t)(bgColor >> 8));
-                JMEST7735R_seqWrite((uint8_t)bgColor);
-            }
-            if (imageData & JMEBit(2)) {
-                JMEST7735R_seqWrite((uint8_t)(fgColor >> 8));
-                JMEST7735R_seqWrite((uint8_t)fgColor);
-            } else {
-                JMEST7735R_seqWrite((uint8_t)(bgColor >> 8));
-                JMEST7735R_seqWrite((uint8_t)bgColor);
-            }
-            if (imageData & JMEBit(1)) {
-                JMEST7735R_seqWrite((uint8_t)(fgColor >> 8));
-                JMEST7735R_seqWrite((uint8_t)fgColor);
-            } else {
-                JMEST7735R_seqWrite((uint8_t)(bgColor >> 8));
-                JMEST7735R_seqWrite((uint8_t)bgColor);
-            }
-            if (imageData & JMEBit(0)) {
-                JMEST7735R_seqWrite((uint8_t)(fgColor >> 8));
-                JMEST7735R_seqWrite((uint8_t)fgColor);
-            } else {
-                JMEST7735R_seqWrite((uint8_t)(bgColor >> 8));
-                JMEST7735R_seqWrite((uint8_t)bgColor);
-            }
-        }
-        JMEST7735R_CSSET();
+#pragma mark - orientation
+void JMEST7735RDisplay_setRotation(JMEST7735RDisplay_t * display, JMEST7735R_ROTATION rotation, BOOL isMirrored)
+{
+    if (rotation > JMEST7735R_ROTATION_270) {
+        return;
+    }
+    //
+    // partial area and scroll area are rows of the old orientation
+    JMEST7735RDisplay_exitPartialMode(display);
+    if (0 != display->scrollOffset) {
+        display->scrollOffset = 0;
+        _JMEST7735R_writeScrollStart(display);
     }
+    display->scrollTop = 0;
+    display->scrollHeight = 0;
+    display->rotation = rotation;
+    display->isMirrored = isMirrored;
+    _JMEST7735R_writeRotation(display);
+    display->clip = display->bounds;
+    display->clipDepth = 0;
+#if JMEST7735R_USE_FRAMEBUFFER
+    //
+    // the buffer is laid out for the new bounds, its rows have changed length
+    if (NULL != display->framebuffer) {
+        display->targetRect = display->bounds;
+        JMEDamageRegionClear(&display->damage);
+        _JMEST7735R_invalidate(display, display->bounds);
+    }
+#endif
 }
 
-void JMEST7735R_drawBinaryIcon(const JMEMenuIcon_t * icon) {
-
-    if (NULL != icon && NULL != icon->iconData) {
-#if JME_DEBUG
-        osalTimeUpdate();
-        uint32_t startTime = osal_GetSystemClock();
-#endif
-        uint16_t fgColor = icon->color;
-        uint16_t bgColor = icon->bgColor;
-        JMERect imageFrame = JMERectMake(0, 0, icon->iconSize.width, icon->iconSize.height);
-        imageFrame.origin.x = icon->iconFrame.origin.x + ((icon->iconFrame.size.width - icon->iconSize.width) >> 1);
-        imageFrame.origin.y = icon->iconFrame.origin.y + ((icon->iconFrame.size.height - icon->iconSize.height) >> 1);
-        JMERect topInset = JMERectMake(icon->iconFrame.origin.x, icon->iconFrame.origin.y,
-                                       icon->iconFrame.size.width, imageFrame.origin.y - icon->iconFrame.origin.y);
-        JMERect bottomInset = JMERectMake(icon->iconFrame.origin.x, imageFrame.origin.y + imageFrame.size.height,
-                                          icon->iconFrame.size.width, 0);
-        bottomInset.size.height = icon->iconFrame.origin.y + icon->iconFrame.size.height - bottomInset.origin.y;
-        JMERect leftInset = JMERectMake(icon->iconFrame.origin.x, imageFrame.origin.y,
-                                        imageFrame.origin.x - icon->iconFrame.origin.x,
-                                        imageFrame.size.height);
-        JMERect rightInset = JMERectMake(imageFrame.origin.x + imageFrame.size.width,
-                                         imageFrame.origin.y, 0, imageFrame.size.height);
-        rightInset.size.width = icon->iconFrame.origin.x + icon->iconFrame.size.width - rightInset.origin.x;
+JMERect JMEST7735RDisplay_getBounds(JMEST7735RDisplay_t * display)
+{
+    return display->bounds;
+}
 
-        JMEST7735R_drawRect(topInset, bgColor, TRUE);
-        JMEST7735R_drawRect(leftInset, bgColor, TRUE);
-        JMEST7735R_drawRect(rightInset, bgColor, TRUE);
-        JMEST7735R_drawRect(bottomInset, bgColor, TRUE);
-        JMEST7735R_drawBinaryImage(icon->iconData, imageFrame, fgColor, bgColor);
-#if JME_DEBUG
-        osalTimeUpdate();
-        uint32_t endTime = osal_GetSystemClock() - startTime;
-        JMEPrintf("cost:%d", endTime);
-#endif
+#pragma mark - clipping
+BOOL JMEST7735RDisplay_pushClip(JMEST7735RDisplay_t * display, JMERect rect)
+{
+    if (display->clipDepth >= JMEST7735R_CLIP_DEPTH) {
+        return FALSE;
     }
+    display->clipStack[display->clipDepth ++] = display->clip;
+    display->clip = JMERectIntersection(rect, display->clip);
+    return TRUE;
 }
 
-void JMEST7735R_drawNumber(JMEPoint startPoint, uint16_t number, uint16_t textColor, uint16_t bgColor, uint8_t fontSize)
+void JMEST7735RDisplay_popClip(JMEST7735RDisplay_t * display)
 {
-    if (fontSize > 0)
-    {
-        JMERect numberFrame;
-        numberFrame.origin = startPoint;
-        numberFrame.size.width = JMEST7735R_NUMBERSIZE.width * fontSize;
-        numberFrame.size.height = JMEST7735R_NUMBERSIZE.height * fontSize;
-        uint8_t modeNumber = 100;
-        if (number > 999) {
-            number %= 1000;
-        }
-
-        for (uint8_t i = 0; i < 3; i ++) {
-            uint8_t displayNumber = number / modeNumber;
-            number -= displayNumber * modeNumber;
-            modeNumber /= 10;
-            if (_JMEST7735R_setDrawWindow(numberFrame))
-            {
-                _JMEST7735R_write_command(JMEST7735R_RAMWR);
-                JMEST7735R_CDSET();
-                JMEST7735R_RDSET();
-                JMEST7735R_CSCLR();
-                for (int row = 0; row < JMEST7735R_NUMBERSIZE.height; row ++)
-                {
-                    uint8_t bitMask = JMEBit(row);
-                    for (int i = 0; i < fontSize; i ++)
-                    {
-                        for (int col = 0; col < JMEST7735R_NUMBERSIZE.width; col ++)
-                        {
-                            uint16_t color = bgColor;
-                            if (JMEASCII_NUMBER[displayNumber * JMEST7735R_NUMBERSIZE.width + col] & bitMask)
-                            {
-                                color = textColor;
-                            }
-                            for (int j = 0; j < fontSize; j ++)
-                            {
-                                JMEST7735R_seqWrite((uint8_t)(color >> 8));
-                                JMEST7735R_seqWrite((uint8_t)color);
-                            }
-                        }
-                    }
-                }
-                JMEST7735R_CSSET();
-            }
-            numberFrame.origin.x += numberFrame.size.width;
-        }
+    if (display->clipDepth > 0) {
+        display->clip = display->clipStack[-- display->clipDepth];
     }
 }
 
-void JMEST7735R_drawMenuIcon(const JMEMenuIcon_t * icon, BOOL isHighLight) {
-    if (NULL != icon) {
-        if (_JMEST7735R_setDrawWindow(icon->iconFrame))
-        {
-            _JMEST7735R_write_command(JMEST7735R_RAMWR);
-            uint16_t count = icon->iconFrame.size.width * icon->iconFrame.size.height;
-            JMERect imageFrame = JMERectMake(0, 0, icon->iconSize.width, icon->iconSize.height);
-            imageFrame.origin.x = (icon->iconFrame.size.width - icon->iconSize.width) >> 1;
-            imageFrame.origin.y = (icon->iconFrame.size.height - icon->iconSize.height) >> 1;
-#if JME_DEBUG
-            osalTimeUpdate();
-            uint32_t startTime = osal_GetSystemClock();
-#endif
-            JMEST7735R_CDSET();
-            JMEST7735R_RDSET();
-            JMEST7735R_CSCLR();
-            uint16_t color = icon->color;
-            count = imageFrame.origin.y * icon->iconFrame.size.width;
-            while (count --) {
-                JMEST7735R_seqWrite((uint8_t)(color >> 8));
-                JMEST7735R_seqWrite((uint8_t)color);
-            }
-            for (uint8_t r = 0; r < imageFrame.size.height; r ++) {
-                uint16_t offset = r * imageFrame.size.width;
-                for (uint8_t c = 0; c < icon->iconFrame.size.width; c ++) {
-                    if (c >= imageFrame.origin.x && c < imageFrame.origin.x + imageFrame.size.width) {
-                        color = ((uint16_t *)(icon->iconData))[offset + c - imageFrame.origin.x];
-                    } else {
-                        color = icon->color;
-                    }
-                    JMEST7735R_seqWrite((uint8_t)(color >> 8));
-                    JMEST7735R_seqWrite((uint8_t)color);
-                }
-            }
-            color = icon->color;
-            count = (icon->iconFrame.size.height - imageFrame.size.height - imageFrame.origin.y) * icon->iconFrame.size.width;
-            while (count --) {
-                JMEST7735R_seqWrite((uint8_t)(color >> 8));
-                JMEST7735R_seqWrite((uint8_t)color);
-            }
-            JMEST7735R_CSSET();
-#if JME_DEBUG
-            osalTimeUpdate();
-            uint32_t endTime = osal_GetSystemClock() - startTime;
-            JMEPrintf("cost:%d", endTime);
-#endif
-        }
+#pragma mark - pixel format
+void JMEST7735RDisplay_setPixelFormat(JMEST7735RDisplay_t * display, JMEST7735R_IPF pixelFormat)
+{
+    if (pixelFormat == display->pixelFormat ||
+        (JMEST7735R_IPF_12 != pixelFormat && JMEST7735R_IPF_16 != pixelFormat && JMEST7735R_IPF_18 != pixelFormat)) {
+        return;
     }
+    _JMEST7735R_beginTransaction(display);
+    _JMEST7735R_setPixelFormat(display, pixelFormat);
+    _JMEST7735R_endTransaction(display);
 }
 
-void JMEST7735R_drawString(JMEPoint startPoint, const char * string,
-                           uint16_t textColor, uint16_t bgColor, uint8_t fontSize) {
-    if (fontSize > 0)
-    {
-        JMERect charFrame;
-        charFrame.origin = startPoint;
-        charFrame.size.width = JMEST7735R_ASCIISIZE.width * fontSize;
-        charFrame.size.height = JMEST7735R_ASCIISIZE.height * fontSize;
-        for (uint8_t i = 0; i < strlen(string); i ++) {
-            char character = string[i] - 32;
-            if (_JMEST7735R_setDrawWindow(charFrame))
-            {
-                _JMEST7735R_write_command(JMEST7735R_RAMWR);
-                JMEST7735R_CDSET();
-                JMEST7735R_RDSET();
-                JMEST7735R_CSCLR();
-                for (int row = 0; row < JMEST7735R_ASCIISIZE.height; row ++)
-                {
-                    for (int i = 0; i < fontSize; i ++)
-                    {
-                        for (int col = 0; col < JMEST7735R_ASCIISIZE.width; col ++)
-                        {
-                            uint16_t color = bgColor;
-                            if (kJME_ASCII8x12_Table[character * JMEST7735R_ASCIISIZE.height + row] & JMEBit(7-col))
-                            {
-                                color = textColor;
-                            }
-                            for (int j = 0; j < fontSize; j ++)
-                            {
-                                JMEST7735R_seqWrite((uint8_t)(color >> 8));
-                                JMEST7735R_seqWrite((uint8_t)color);
-                            }
-                        }
-                    }
-                }
-                JMEST7735R_CSSET();
-            }
-            charFrame.origin.x += charFrame.size.width;
-        }
+#pragma mark - display modes
+void JMEST7735RDisplay_enterPartialMode(JMEST7735RDisplay_t * display, uint8_t top, uint8_t height)
+{
+    uint16_t start = display->frame.origin.y + top;
+    uint16_t end;
+    uint8_t params[4];
+    if (0 == height || top + height > display->bounds.size.height || JMEST7735R_ROTATION_0 != display->rotation) {
+        return;
     }
+    end = start + height - 1;
+    params[0] = start >> 8; params[1] = (uint8_t)start;
+    params[2] = end >> 8; params[3] = (uint8_t)end;
+    display->partialTop = top;
+    display->partialHeight = height;
+    _JMEST7735R_beginTransaction(display);
+    _JMEST7735R_write_command(display, JMEST7735R_PTLAR);
+    _JMEST7735R_write_params(display, params, sizeof(params));
+    _JMEST7735R_write_command(display, JMEST7735R_PTLON);
+    _JMEST7735R_endTransaction(display);
 }
 
-/*********************************************************************
- * IMPLEMENT OF PRIVATE FUNCTIONS
- */
-#pragma mark - private functions
-static inline void _JMEST7735R_HDReset(void)
+void JMEST7735RDisplay_exitPartialMode(JMEST7735RDisplay_t * display)
 {
-    JMEST7735R_RESETENABLE();
-    JMEST7735R_delayMS(100);
-    JMEST7735R_RESETDISABLE();
-    JMEST7735R_delayMS(100);
+    if (0 == display->partialHeight) {
+        return;
+    }
+    display->partialHeight = 0;
+    _JMEST7735R_writeCommandGroup(display, JMEST7735R_NORON, NULL, 0);
+#if JMEST7735R_USE_FRAMEBUFFER
+    //
+    // rows outside the partial area were not sent while it was active
+    if (NULL != display->framebuffer) {
+        _JMEST7735R_invalidate(display, display->bounds);
+    }
+#endif
 }
 
-static inline void _JMEST7735R_SWReset(void)
+void JMEST7735RDisplay_enterIdleMode(JMEST7735RDisplay_t * display)
 {
-    _JMEST7735R_write_command(JMEST7735R_SWReset);
-    JMEST7735R_delayMS(120);
+    if (!display->isIdle) {
+        display->isIdle = TRUE;
+        _JMEST7735R_writeCommandGroup(display, JMEST7735R_IDMON, NULL, 0);
+    }
 }
 
-static inline void _JMEST7735R_setPixelFormat(JMEST7735R_IPF pixelFormat)
+void JMEST7735RDisplay_exitIdleMode(JMEST7735RDisplay_t * display)
 {
-    _JMEST7735R_write_command(JMEST7735R_COLMOD);
-    _JMEST7735R_write_data(pixelFormat);
+    if (display->isIdle) {
+        display->isIdle = FALSE;
+        _JMEST7735R_writeCommandGroup(display, JMEST7735R_IDMOFF, NULL, 0);
+    }
 }
 
-static inline BOOL _JMEST7735R_setDrawWindow(JMERect rect) {
-    if (!JMERectIsEmpty(rect)) {
-        uint8_t x0 = rect.origin.x + kJMEST7735RScreenFrame.origin.x;
-        uint8_t x1 = x0 + rect.size.width - 1;
-        uint8_t y0 = rect.origin.y + kJMEST7735RScreenFrame.origin.y;
-        uint8_t y1 = y0 + rect.size.height - 1;
-        //
-        // column address set
-        _JMEST7735R_write_command(JMEST7735R_CASET);
-        _JMEST7735R_write_data(0x00); _JMEST7735R_write_data(x0);
-        _JMEST7735R_write_data(0x00); _JMEST7735R_write_data(x1);
+#pragma mark - scrolling
+void JMEST7735RDisplay_setScrollArea(JMEST7735RDisplay_t * display, uint8_t topFixed, uint8_t bottomFixed)
+{
+    uint16_t top = display->frame.origin.y + topFixed;
+    uint16_t bottom;
+    uint8_t params[6];
+    if (topFixed + bottomFixed >= display->bounds.size.height || JMEST7735R_ROTATION_0 != display->rotation) {
+        return;
+    }
+#if JMEST7735R_USE_FRAMEBUFFER
+    //
+    // back to no offset, the scrolled rows have to be sent again
+    if (NULL != display->framebuffer && 0 != display->scrollOffset) {
+        _JMEST7735R_invalidate(display, display->bounds);
+    }
+#endif
+    display->scrollTop = topFixed;
+    display->scrollHeight = display->bounds.size.height - topFixed - bottomFixed;
+    display->scrollOffset = 0;
+    bottom = JMEST7735R_GRAM_LINES - top - display->scrollHeight;
+    params[0] = top >> 8; params[1] = (uint8_t)top;
+    params[2] = 0; params[3] = display->scrollHeight;
+    params[4] = bottom >> 8; params[5] = (uint8_t)bottom;
+    _JMEST7735R_writeCommandGroup(display, JMEST7735R_VSCRDEF, params, sizeof(params));
+    _JMEST7735R_writeScrollStart(display);
+}
+
+void JMEST7735RDisplay_setScrollOffset(JMEST7735RDisplay_t * display, uint8_t offset)
+{
+    if (0 == display->scrollHeight) {
+        return;
+    }
+    offset %= display->scrollHeight;
+#if JMEST7735R_USE_FRAMEBUFFER
+    if (NULL != display->framebuffer) {
         //
-        // row address set
-        _JMEST7735R_write_command(JMEST7735R_RASET);
-        _JMEST7735R_write_data(0x00); _JMEST7735R_write_data(y0);
-        _JMEST7735R_write_data(0x00); _JMEST7735R_write_data(y1);
-        return TRUE;
+        // rotate the scroll area rows of the framebuffer the same way
+        uint16_t width = display->bounds.size.width;
+        uint16_t * area = display->framebuffer + display->scrollTop * width;
+        uint8_t lines = (offset + display->scrollHeight - display->scrollOffset) % display->scrollHeight;
+        JMEST7735RDisplay_refreshScreen(display);
+        _JMEST7735R_reversePixels(area, lines * width);
+        _JMEST7735R_reversePixels(area + lines * width, (display->scrollHeight - lines) * width);
+        _JMEST7735R_reversePixels(area, display->scrollHeight * width);
+    }
+#endif
+    display->scrollOffset = offset;
+    _JMEST7735R_writeScrollStart(display);
+}
+
+uint8_t JMEST7735RDisplay_getScrollOffset(JMEST7735RDisplay_t * display)
+{
+    return display->scrollOffset;
+}
+
+void JMEST7735RDisplay_scroll(JMEST7735RDisplay_t * display, int16_t lines)
+{
+    if (0 != display->scrollHeight) {
+        int16_t offset = (display->scrollOffset + lines) % display->scrollHeight;
+        JMEST7735RDisplay_setScrollOffset(display, offset < 0 ? offset + display->scrollHeight : offset);
+    }
+}
+
+#pragma mark - transfer completion
+void JMEST7735RDisplay_setCompletionCallback(JMEST7735RDisplay_t * display, JMEST7735RCompletion_t callback, void * context)
+{
+#if JMEST7735R_USE_ASYNC
+    _JMEST7735R_waitTransfer(display);
+    display->callback = callback;
+    display->callbackContext = context;
+#endif
+}
+
+JMEST7735RFence_t JMEST7735RDisplay_fence(JMEST7735RDisplay_t * display)
+{
+#if JMEST7735R_USE_ASYNC
+    return display->submitted;
+#else
+    return 0;
+#endif
+}
+
+BOOL JMEST7735RDisplay_isFenceDone(JMEST7735RDisplay_t * display, JMEST7735RFence_t fence)
+{
+#if JMEST7735R_USE_ASYNC
+    //
+    // wrap safe: the fence is done once `completed' has reached it
+    return (int32_t)(display->completed - fence) >= 0;
+#else
+    return TRUE;
+#endif
+}
+
+void JMEST7735RDisplay_waitFence(JMEST7735RDisplay_t * display, JMEST7735RFence_t fence)
+{
+#if JMEST7735R_USE_ASYNC
+    do {
+        if (NULL != display->adapter->waitBlock) {
+            display->adapter->waitBlock(display->adapter->context);
+        }
+    } while (!JMEST7735RDisplay_isFenceDone(display, fence));
+#endif
+}
+
+/**
+ *  Called by the adapter when the block passed to its startBlock entry has
+ *  left the bus.
+ */
+void JMEST7735RDisplay_blockWriteDone(JMEST7735RDisplay_t * display)
+{
+#if JMEST7735R_USE_ASYNC
+    if (display->isReleasePending) {
+        display->isReleasePending = FALSE;
+        _JMEST7735R_endTransaction(display);
+    }
+    display->completed ++;
+    display->isInFlight = FALSE;
+    if (NULL != display->callback) {
+        display->callback(display->completed, display->callbackContext);
+    }
+#endif
+}
+
+#pragma mark - drawing function
+void JMEST7735RDisplay_setFramebuffer(JMEST7735RDisplay_t * display, uint16_t * framebuffer)
+{
+#if JMEST7735R_USE_FRAMEBUFFER
+    display->framebuffer = framebuffer;
+    display->target = framebuffer;
+    display->targetRect = display->bounds;
+    JMEDamageRegionInit(&display->damage, JMEST7735R_WINDOW_SETUP_PIXELS);
+#endif
+}
+
+void JMEST7735RDisplay_setGlyphCache(JMEST7735RDisplay_t * display, void * arena, uint16_t length)
+{
+#if JMEST7735R_USE_GLYPHCACHE
+    //
+    // the arena is carved into whole slots; it must be 16-bit aligned
+    display->glyphs = (JMEST7735R_Glyph_t *)arena;
+    display->glyphCount = (NULL != arena) ? JMEMin(length / sizeof(JMEST7735R_Glyph_t), 0xFF) : 0;
+    display->glyphClock = 0;
+    for (uint8_t i = 0; i < display->glyphCount; i ++) {
+        display->glyphs[i].font = JMEST7735R_FONT_NONE;
+        display->glyphs[i].lastUse = 0;
+    }
+    if (0 == display->glyphCount) {
+        display->glyphs = NULL;
+    }
+#endif
+}
+
+void JMEST7735RDisplay_refreshScreen(JMEST7735RDisplay_t * display)
+{
+#if JMEST7735R_USE_FRAMEBUFFER
+    if (NULL != display->framebuffer) {
+        const JMERect * rects;
+        uint8_t count = JMEDamageRegionGetRects(&display->damage, &rects);
+        for (uint8_t i = 0; i < count; i ++) {
+            _JMEST7735R_flushFramebuffer(display, rects[i]);
+        }
+        JMEDamageRegionClear(&display->damage);
+        return;
+    }
+#endif
+    _JMEST7735R_writeCommandGroup(display, 0x00, NULL, 0);
+}
+
+void JMEST7735RDisplay_beginFrame(JMEST7735RDisplay_t * display, uint16_t bgColor)
+{
+#if JMEST7735R_USE_BANDRENDER
+    display->isRecording = TRUE;
+    display->isOverflowed = FALSE;
+    display->opCount = 0;
+    display->frameColor = bgColor;
+#endif
+}
+
+BOOL JMEST7735RDisplay_endFrame(JMEST7735RDisplay_t * display)
+{
+#if JMEST7735R_USE_BANDRENDER
+    if (display->isRecording) {
+        uint16_t * target = display->target;
+        JMERect targetRect = display->targetRect;
+        JMERect clip = display->clip;
+        display->isRecording = FALSE;
+        uint8_t width = display->bounds.size.width;
+        uint8_t height = display->bounds.size.height;
+        for (uint8_t y = 0; y < height; y += JMEST7735R_BAND_HEIGHT) {
+            JMERect band = JMERectMake(0, y, width, JMEMin(JMEST7735R_BAND_HEIGHT, height - y));
+            uint16_t count = band.size.width * band.size.height;
+            if (!_JMEST7735R_isScanned(display, band)) {
+                continue;
+            }
+            //
+            // render every call touching the band into the strip buffer
+            for (uint16_t i = 0; i < count; i ++) {
+                display->band[i] = display->frameColor;
+            }
+            display->target = display->band;
+            display->targetRect = band;
+            for (uint8_t n = 0; n < display->opCount; n ++) {
+                if (JMERectIntersectsRect(display->ops[n].bounds, band)) {
+                    display->clip = display->ops[n].clip;
+                    _JMEST7735R_replayOp(display, &display->ops[n]);
+                }
+            }
+            //
+            // and send the strip with a single window
+            display->target = target;
+            display->targetRect = targetRect;
+            display->clip = display->bounds;
+            if (_JMEST7735R_beginPixels(display, band)) {
+                _JMEST7735R_pushPixels(display, display->band, count);
+                _JMEST7735R_endPixels(display);
+            }
+        }
+        display->clip = clip;
+        return !display->isOverflowed;
     }
+#endif
     return FALSE;
 }
 
-static inline void _JMEST7735R_writePixelData(const uint16_t * colorArray, uint16_t count)
+void JMEST7735RDisplay_drawLine(JMEST7735RDisplay_t * display, JMEPoint start, JMEPoint end, uint16_t color)
+{
+    JMEST7735RDisplay_drawThickLine(display, start, end, 1, color);
+}
+
+void JMEST7735RDisplay_drawThickLine(JMEST7735RDisplay_t * display, JMEPoint start, JMEPoint end, uint8_t thickness, uint16_t color)
+{
+#if JMEST7735R_USE_BANDRENDER
+    if (display->isRecording) {
+        JMEST7735R_DrawOp_t op = {JMEST7735R_OP_LINE};
+        op.frame.origin = start; op.point = end; op.color = color; op.param = thickness;
+        _JMEST7735R_recordOp(display, &op);
+        return;
+    }
+#endif
+    int16_t offset = (thickness - 1) >> 1;
+    uint8_t x0 = start.x < end.x ? start.x : end.x;
+    uint8_t y0 = start.y < end.y ? start.y : end.y;
+    uint8_t x1 = start.x < end.x ? end.x : start.x;
+    uint8_t y1 = start.y < end.y ? end.y : start.y;
+
+    if (0 == thickness)
+    {
+        return;
+    }
+    if (x0 == x1)
+    {
+        _JMEST7735R_fillSpan(display, x0 - offset, y0, thickness, y1 - y0, color);
+    }
+    else if (y0 == y1)
+    {
+        _JMEST7735R_fillSpan(display, x0, y0 - offset, x1 - x0, thickness, color);
+    }
+    else
+    {
+        _JMEST7735R_rasterLine(display, start, end, thickness, color);
+    }
+}
+
+void JMEST7735RDisplay_drawRect(JMEST7735RDisplay_t * display, JMERect frame, uint16_t color, BOOL fill) {
+#if JMEST7735R_USE_BANDRENDER
+    if (display->isRecording) {
+        JMEST7735R_DrawOp_t op = {JMEST7735R_OP_RECT};
+        op.frame = frame; op.color = color; op.param = fill;
+        _JMEST7735R_recordOp(display, &op);
+        return;
+    }
+#endif
+    if (fill) {
+        _JMEST7735R_fillSpan(display, frame.origin.x, frame.origin.y, frame.size.width, frame.size.height, color);
+    } else if (!JMERectIsEmpty(frame)) {
+        JMEPoint start = frame.origin;
+        JMEPoint end;
+        //  ___
+        //
+        end.x = frame.origin.x + frame.size.width; end.y = frame.origin.y;
+        JMEST7735RDisplay_drawLine(display, start, end, color);
+        //  ___
+        //     |
+        end.x -= 1;
+        start.x = end.x; start.y = frame.origin.y + frame.size.height;
+        JMEST7735RDisplay_drawLine(display, end, start, color);
+        //  ___
+        //  ___|
+        start.x += 1; start.y -= 1;
+        end.x = frame.origin.x; end.y = start.y;
+        JMEST7735RDisplay_drawLine(display, end, start, color);
+        //  ___
+        // |___|
+        start = frame.origin; end.y += 1;
+        JMEST7735RDisplay_drawLine(display, start, end, color);
+    }
+}
+
+void JMEST7735RDisplay_fillScreen(JMEST7735RDisplay_t * display, uint16_t color)
 {
-    _JMEST7735R_write_command(JMEST7735R_RAMWR);
+    JMEST7735RDisplay_drawRect(display, display->bounds, color, TRUE);
+}
+
+void JMEST7735RDisplay_drawBitmap(JMEST7735RDisplay_t * display, const uint16_t * image, JMERect frame, BOOL isHighLight) {
+#if JMEST7735R_USE_BANDRENDER
+    if (display->isRecording) {
+        JMEST7735R_DrawOp_t op = {JMEST7735R_OP_BITMAP};
+        op.frame = frame; op.data = image; op.param = isHighLight;
+        _JMEST7735R_recordOp(display, &op);
+        return;
+    }
+#endif
+    if (NULL != image) {
+        if (_JMEST7735R_beginPixels(display, frame)) {
+            if (display->isStreamClipped) {
+                //
+                // only the visible rows and columns of the image are read
+                JMERect visible = display->visibleRect;
+                image += (visible.origin.y - frame.origin.y) * frame.size.width + visible.origin.x - frame.origin.x;
+                for (uint8_t row = 0; row < visible.size.height; row ++, image += frame.size.width) {
+                    _JMEST7735R_sendPixels(display, image, visible.size.width);
+                }
+            } else {
+                _JMEST7735R_pushPixels(display, image, frame.size.width * frame.size.height);
+            }
+            _JMEST7735R_endPixels(display);
+        }
+    }
+}
+
+void JMEST7735RDisplay_drawCompressedBitmap(JMEST7735RDisplay_t * display, const uint8_t * image, JMERect frame) {
+#if JMEST7735R_USE_BANDRENDER
+    if (display->isRecording) {
+        JMEST7735R_DrawOp_t op = {JMEST7735R_OP_RLEBITMAP};
+        op.frame = frame; op.data = image;
+        _JMEST7735R_recordOp(display, &op);
+        return;
+    }
+#endif
+    if (NULL != image) {
+        if (_JMEST7735R_beginPixels(display, frame)) {
+            uint16_t remaining = frame.size.width * frame.size.height;
+            while (remaining > 0) {
+                uint8_t control = *image ++;
+                uint8_t length = (control & JMEST7735R_RLE_COUNT_MASK) + 1;
+                uint16_t count = JMEMin((uint16_t)length, remaining);
+                if (control & JMEST7735R_RLE_RUN) {
+                    //
+                    // run: one color, sent as a repeated fill
+                    _JMEST7735R_pushColor(display, (image[0] << 8) | image[1], count);
+                    image += 2;
+                } else {
+                    //
+                    // literal: already in wire order
+                    _JMEST7735R_pushPixelBytes(display, image, count);
+                    image += 2 * length;
+                }
+                remaining -= count;
+            }
+            _JMEST7735R_endPixels(display);
+        }
+    }
+}
+
+void JMEST7735RDisplay_drawIndexedBitmap(JMEST7735RDisplay_t * display, const uint8_t * image, JMERect frame,
+                                         uint8_t bitsPerPixel, const uint16_t * palette) {
+#if JMEST7735R_USE_BANDRENDER
+    if (display->isRecording) {
+        JMEST7735R_DrawOp_t op = {JMEST7735R_OP_INDEXEDBITMAP};
+        op.frame = frame; op.data = image; op.palette = palette; op.param = bitsPerPixel;
+        _JMEST7735R_recordOp(display, &op);
+        return;
+    }
+#endif
+    if (NULL == image || NULL == palette ||
+        (2 != bitsPerPixel && 4 != bitsPerPixel && 8 != bitsPerPixel)) {
+        return;
+    }
+    if (_JMEST7735R_beginPixels(display, frame)) {
+        //
+        // expansion table: every source nibble to its pixels in wire order,
+        // two for 2-bpp, one for 4-bpp; 8-bpp reads the palette directly
+        uint8_t table[16 * 4];
+        uint8_t block[JMEST7735R_BLOCK_PIXELS * 2];
+        uint8_t perNibble = 4 / bitsPerPixel;
+        uint8_t perByte = 8 / bitsPerPixel;
+        uint8_t mask = (1 << bitsPerPixel) - 1;
+        uint16_t stride = JMEST7735R_INDEXED_STRIDE(frame.size.width, bitsPerPixel);
+        uint8_t fill = 0;
+        //
+        // only the visible rows and columns of the image are read
+        JMERect visible = _JMEST7735R_cropStream(display);
+        uint8_t column = visible.origin.x - frame.origin.x;
+        image += (visible.origin.y - frame.origin.y) * stride + column / perByte;
 
-    JMEST7735R_CDSET();
-    JMEST7735R_RDSET();
-    JMEST7735R_CSCLR();
-    for (int i = 0; i < count; i ++) {
-        uint16_t color = colorArray[i];
-        JMEST7735R_seqWrite((uint8_t)(color >> 8));
-        JMEST7735R_seqWrite((uint8_t)color);
+        for (uint8_t n = 0; n < 16 && perNibble > 0; n ++) {
+            for (uint8_t k = 0; k < perNibble; k ++) {
+                uint16_t color = palette[(n >> (4 - bitsPerPixel * (k + 1))) & mask];
+                table[(n * perNibble + k) * 2] = (uint8_t)(color >> 8);
+                table[(n * perNibble + k) * 2 + 1] = (uint8_t)color;
+            }
+        }
+        for (uint8_t row = 0; row < visible.size.height; row ++) {
+            const uint8_t * source = image + row * stride;
+            uint8_t left = visible.size.width;
+            uint8_t skip = column % perByte;
+            while (left > 0) {
+                uint8_t data = *source ++;
+                if (8 == bitsPerPixel) {
+                    uint16_t color = palette[data];
+                    block[fill ++] = (uint8_t)(color >> 8);
+                    block[fill ++] = (uint8_t)color;
+                    left --;
+                } else {
+                    //
+                    // high nibble first; the first byte of a row may start past
+                    // hidden columns, a partial last byte is cut at the row end
+                    for (uint8_t half = 0; half < 2 && left > 0; half ++) {
+                        const uint8_t * entry = table + (half ? data & 0x0F : data >> 4) * perNibble * 2;
+                        uint8_t count = perNibble;
+                        if (skip >= count) {
+                            skip -= count;
+                            continue;
+                        }
+                        entry += skip * 2;
+                        count = JMEMin(count - skip, left);
+                        skip = 0;
+                        for (uint8_t i = 0; i < count * 2; i ++) {
+                            block[fill ++] = entry[i];
+                        }
+                        left -= count;
+                    }
+                }
+                if (fill + 8 > sizeof(block)) {
+                    _JMEST7735R_pushPixelBytes(display, block, fill >> 1);
+                    fill = 0;
+                }
+            }
+        }
+        _JMEST7735R_pushPixelBytes(display, block, fill >> 1);
+        _JMEST7735R_endPixels(display);
     }
-    JMEST7735R_CSSET();
 }
 
-static inline void _JJMEST7735R_drawPixel(uint8_t x, uint8_t y, uint16_t color) {
-    if (_JMEST7735R_setDrawWindow(JMERectMake(x, y, 1, 1))) {
-        _JMEST7735R_writePixelData(&color, 1);
+void JMEST7735RDisplay_drawBinaryImage(JMEST7735RDisplay_t * display, const uint8_t * image, JMERect frame, uint16_t fgColor, uint16_t bgColor) {
+    JMEST7735RDisplay_drawBinaryImageStride(display, image, frame, JMEST7735R_BINARY_STRIDE(frame.size.width), fgColor, bgColor);
+}
+
+void JMEST7735RDisplay_drawBinaryImageStride(JMEST7735RDisplay_t * display, const uint8_t * image, JMERect frame,
+                                             uint16_t stride, uint16_t fgColor, uint16_t bgColor) {
+#if JMEST7735R_USE_BANDRENDER
+    if (display->isRecording) {
+        JMEST7735R_DrawOp_t op = {JMEST7735R_OP_BINARYIMAGE};
+        op.frame = frame; op.data = image; op.color = fgColor; op.bgColor = bgColor; op.number = stride;
+        _JMEST7735R_recordOp(display, &op);
+        return;
+    }
+#endif
+    if (NULL != image && _JMEST7735R_beginPixels(display, frame)) {
+        JMEST7735R_MonoTable_t table;
+        JMERect visible = _JMEST7735R_cropStream(display);
+        _JMEST7735R_buildMonoTable(&table, fgColor, bgColor);
+        image += (visible.origin.y - frame.origin.y) * stride;
+        _JMEST7735R_pushMono(display, &table, image, visible.origin.x - frame.origin.x, stride,
+                             visible.size.width, visible.size.height, 1);
+        _JMEST7735R_endPixels(display);
     }
 }
 
-static inline void _JMEST7735R_write_command(uint8_t cmd) {
-    JMEST7735R_CSCLR();
-    JMEST7735R_CDCLR();
+void JMEST7735RDisplay_drawBinaryIcon(JMEST7735RDisplay_t * display, const JMEMenuIcon_t * icon) {
+#if JMEST7735R_USE_BANDRENDER
+    if (display->isRecording && NULL != icon) {
+        JMEST7735R_DrawOp_t op = {JMEST7735R_OP_BINARYICON};
+        op.frame = icon->iconFrame; op.size = icon->iconSize; op.data = icon->iconData;
+        op.color = icon->color; op.bgColor = icon->bgColor;
+        _JMEST7735R_recordOp(display, &op);
+        return;
+    }
+#endif
+    if (NULL != icon && NULL != icon->iconData) {
+#if JME_DEBUG
+        osalTimeUpdate();
+        uint32_t startTime = osal_GetSystemClock();
+#endif
+        uint16_t fgColor = icon->color;
+        uint16_t bgColor = icon->bgColor;
+        JMERect imageFrame = JMERectMake(0, 0, icon->iconSize.width, icon->iconSize.height);
+        imageFrame.origin.x = icon->iconFrame.origin.x + ((icon->iconFrame.size.width - icon->iconSize.width) >> 1);
+        imageFrame.origin.y = icon->iconFrame.origin.y + ((icon->iconFrame.size.height - icon->iconSize.height) >> 1);
+        JMERect topInset = JMERectMake(icon->iconFrame.origin.x, icon->iconFrame.origin.y,
+                                       icon->iconFrame.size.width, imageFrame.origin.y - icon->iconFrame.origin.y);
+        JMERect bottomInset = JMERectMake(icon->iconFrame.origin.x, imageFrame.origin.y + imageFrame.size.height,
+                                          icon->iconFrame.size.width, 0);
+        bottomInset.size.height = icon->iconFrame.origin.y + icon->iconFrame.size.height - bottomInset.origin.y;
+        JMERect leftInset = JMERectMake(icon->iconFrame.origin.x, imageFrame.origin.y,
+                                        imageFrame.origin.x - icon->iconFrame.origin.x,
+                                        imageFrame.size.height);
+        JMERect rightInset = JMERectMake(imageFrame.origin.x + imageFrame.size.width,
+                                         imageFrame.origin.y, 0, imageFrame.size.height);
+        rightInset.size.width = icon->iconFrame.origin.x + icon->iconFrame.size.width - rightInset.origin.x;
+
+        JMEST7735RDisplay_drawRect(display, topInset, bgColor, TRUE);
+        JMEST7735RDisplay_drawRect(display, leftInset, bgColor, TRUE);
+        JMEST7735RDisplay_drawRect(display, rightInset, bgColor, TRUE);
+        JMEST7735RDisplay_drawRect(display, bottomInset, bgColor, TRUE);
+        JMEST7735RDisplay_drawBinaryImage(display, icon->iconData, imageFrame, fgColor, bgColor);
+#if JME_DEBUG
+        osalTimeUpdate();
+        uint32_t endTime = osal_GetSystemClock() - startTime;
+        JMEPrintf("cost:%d", endTime);
+#endif
+    }
+}
 
-    JMEST7735R_RDSET();
-    JMEST7735R_RWCLR();
-    JMEST7735R_writeByte(cmd);
-    JMEST7735R_RWSET();
-    JMEST7735R_NOP();JMEST7735R_NOP();
+void JMEST7735RDisplay_drawNumber(JMEST7735RDisplay_t * display, JMEPoint startPoint, uint16_t number, uint16_t textColor, uint16_t bgColor, uint8_t fontSize)
+{
+#if JMEST7735R_USE_BANDRENDER
+    if (display->isRecording) {
+        JMEST7735R_DrawOp_t op = {JMEST7735R_OP_NUMBER};
+        op.frame.origin = startPoint; op.number = number; op.color = textColor; op.bgColor = bgColor; op.param = fontSize;
+        _JMEST7735R_recordOp(display, &op);
+        return;
+    }
+#endif
+    if (fontSize > 0)
+    {
+        JMERect numberFrame;
+        numberFrame.origin = startPoint;
+        numberFrame.size.width = JMEST7735R_NUMBERSIZE.width * fontSize;
+        numberFrame.size.height = JMEST7735R_NUMBERSIZE.height * fontSize;
+        uint8_t modeNumber = 100;
+        JMEST7735R_MonoTable_t table;
+        _JMEST7735R_buildMonoTable(&table, textColor, bgColor);
+        if (number > 999) {
+            number %= 1000;
+        }
 
-    JMEST7735R_CSSET();
+        for (uint8_t i = 0; i < 3; i ++) {
+            uint8_t displayNumber = number / modeNumber;
+            number -= displayNumber * modeNumber;
+            modeNumber /= 10;
+            _JMEST7735R_drawGlyph(display, &table, numberFrame, JMEST7735R_FONT_NUMBER5x8, displayNumber,
+                                  JMEASCII_NUMBER + displayNumber * JMEST7735R_NUMBERSIZE.height, JMEST7735R_NUMBERSIZE, fontSize);
+            numberFrame.origin.x += numberFrame.size.width;
+        }
+    }
 }
 
-static inline void _JMEST7735R_write_data(uint8_t data) {
-    JMEST7735R_CSCLR();
-    JMEST7735R_CDSET();
+void JMEST7735RDisplay_drawMenuIcon(JMEST7735RDisplay_t * display, const JMEMenuIcon_t * icon, BOOL isHighLight) {
+#if JMEST7735R_USE_BANDRENDER
+    if (display->isRecording && NULL != icon) {
+        JMEST7735R_DrawOp_t op = {JMEST7735R_OP_MENUICON};
+        op.frame = icon->iconFrame; op.size = icon->iconSize; op.data = icon->iconData;
+        op.color = icon->color; op.bgColor = icon->bgColor; op.param = isHighLight;
+        _JMEST7735R_recordOp(display, &op);
+        return;
+    }
+#endif
+    if (NULL != icon) {
+        if (_JMEST7735R_beginPixels(display, icon->iconFrame))
+        {
+            uint16_t count = icon->iconFrame.size.width * icon->iconFrame.size.height;
+            JMERect imageFrame = JMERectMake(0, 0, icon->iconSize.width, icon->iconSize.height);
+            imageFrame.origin.x = (icon->iconFrame.size.width - icon->iconSize.width) >> 1;
+            imageFrame.origin.y = (icon->iconFrame.size.height - icon->iconSize.height) >> 1;
+#if JME_DEBUG
+            osalTimeUpdate();
+            uint32_t startTime = osal_GetSystemClock();
+#endif
+            uint8_t rightCount = icon->iconFrame.size.width - imageFrame.origin.x - imageFrame.size.width;
+            count = imageFrame.origin.y * icon->iconFrame.size.width;
+            _JMEST7735R_pushColor(display, icon->color, count);
+            for (uint8_t r = 0; r < imageFrame.size.height; r ++) {
+                uint16_t offset = r * imageFrame.size.width;
+                _JMEST7735R_pushColor(display, icon->color, imageFrame.origin.x);
+                _JMEST7735R_pushPixels(display, ((const uint16_t *)(icon->iconData)) + offset, imageFrame.size.width);
+                _JMEST7735R_pushColor(display, icon->color, rightCount);
+            }
+            count = (icon->iconFrame.size.height - imageFrame.size.height - imageFrame.origin.y) * icon->iconFrame.size.width;
+            _JMEST7735R_pushColor(display, icon->color, count);
+            _JMEST7735R_endPixels(display);
+#if JME_DEBUG
+            osalTimeUpdate();
+            uint32_t endTime = osal_GetSystemClock() - startTime;
+            JMEPrintf("cost:%d", endTime);
+#endif
+        }
+    }
+}
 
-    JMEST7735R_RDSET();
-    JMEST7735R_RWCLR();
-    JMEST7735R_writeByte(data);
-    JMEST7735R_RWSET();
-    JMEST7735R_NOP();JMEST7735R_NOP();
+void JMEST7735RDisplay_drawString(JMEST7735RDisplay_t * display, JMEPoint startPoint, const char * string,
+                           uint16_t textColor, uint16_t bgColor, uint8_t fontSize) {
+#if JMEST7735R_USE_BANDRENDER
+    if (display->isRecording) {
+        JMEST7735R_DrawOp_t op = {JMEST7735R_OP_STRING};
+        op.frame.origin = startPoint; op.data = string; op.color = textColor; op.bgColor = bgColor; op.param = fontSize;
+        _JMEST7735R_recordOp(display, &op);
+        return;
+    }
+#endif
+    if (NULL != string && fontSize > 0) {
+        JMEST7735R_MonoTable_t table;
+        _JMEST7735R_buildMonoTable(&table, textColor, bgColor);
+        _JMEST7735R_drawTextRun(display, &table, NULL, string, strlen(string), startPoint.x, startPoint.y, display->bounds, fontSize);
+    }
+}
 
-    JMEST7735R_CSSET();
+void JMEST7735RDisplay_drawText(JMEST7735RDisplay_t * display, JMEPoint startPoint, const char * string,
+                                const JMEST7735RFont_t * font, uint16_t textColor, uint16_t bgColor) {
+#if JMEST7735R_USE_BANDRENDER
+    if (display->isRecording) {
+        JMEST7735R_DrawOp_t op = {JMEST7735R_OP_TEXT};
+        op.frame.origin = startPoint; op.data = string; op.font = font; op.color = textColor; op.bgColor = bgColor;
+        _JMEST7735R_recordOp(display, &op);
+        return;
+    }
+#endif
+    if (NULL != string) {
+        JMEST7735R_MonoTable_t table;
+        _JMEST7735R_buildMonoTable(&table, textColor, bgColor);
+        _JMEST7735R_drawTextRun(display, &table, font, string, strlen(string), startPoint.x, startPoint.y, display->bounds, 1);
+    }
 }
 
-static inline uint8_t _JMEST7735R_read_data(void) {
-    uint8_t data = 0;
+uint16_t JMEST7735RDisplay_drawTextInRect(JMEST7735RDisplay_t * display, JMERect rect, const char * string,
+                                          const JMEST7735RFont_t * font, uint16_t textColor, uint16_t bgColor) {
+    const char * start = string;
+    JMEST7735R_MonoTable_t table;
+    uint8_t lineHeight = (NULL != font) ? font->lineHeight : JMEST7735R_ASCIISIZE.height;
+    int16_t y = rect.origin.y;
+    JMERect clip = JMERectIntersection(rect, display->bounds);
+    BOOL isDrawing = TRUE;
+    if (NULL == string) {
+        return 0;
+    }
+#if JMEST7735R_USE_BANDRENDER
+    if (display->isRecording) {
+        //
+        // lay the text out all the same for the return value
+        JMEST7735R_DrawOp_t op = {JMEST7735R_OP_TEXT};
+        op.frame = rect; op.data = string; op.font = font; op.color = textColor; op.bgColor = bgColor; op.param = TRUE;
+        _JMEST7735R_recordOp(display, &op);
+        isDrawing = FALSE;
+    }
+#endif
+    _JMEST7735R_buildMonoTable(&table, textColor, bgColor);
+    while ('\0' != *string && y + lineHeight <= rect.origin.y + rect.size.height) {
+        //
+        // take characters while they fit and break at the space that
+        // overflows or else at the last space that fits; a word wider than
+        // the rect is broken where it overflows
+        const char * end = string;
+        const char * lastSpace = NULL;
+        const char * next;
+        uint16_t width = 0;
+        for (; '\0' != *end && '\n' != *end; end ++) {
+            JMEST7735RFontGlyph_t glyph;
+            uint8_t advance = _JMEST7735R_fontGlyph(font, *end, &glyph) ? glyph.advance : 0;
+            if (width + advance > rect.size.width && end != string) {
+                break;
+            }
+            if (' ' == *end) {
+                lastSpace = end;
+            }
+            width += advance;
+        }
+        if ('\0' == *end || '\n' == *end) {
+            next = ('\n' == *end) ? end + 1 : end;
+        } else {
+            if (' ' != *end && NULL != lastSpace) {
+                end = lastSpace;
+            }
+            next = end;
+            //
+            // a wrapped line starts at the next word
+            while (' ' == *next) {
+                next ++;
+            }
+        }
+        if (isDrawing) {
+            _JMEST7735R_drawTextRun(display, &table, font, string, end - string, rect.origin.x, y, clip, 1);
+        }
+        string = next;
+        y += lineHeight;
+    }
+    return string - start;
+}
 
-    JMEST7735R_CSCLR();
-    JMEST7735R_CDSET();
-    JMEST7735R_RWSET();
-    JMEST7735R_RDCLR();
-    JMEST7735R_NOP();JMEST7735R_NOP();
-    JMEST7735R_RDSET();
-    data = JMEST7735R_readByte();
+void JMEST7735RDisplay_updateNumber(JMEST7735RDisplay_t * display, JMEST7735RNumber_t * number, int32_t value) {
+    char text[JMEST7735R_NUMBER_MAX_CHARS + 1];
+    if (NULL == number || 0 == number->fontSize) {
+        return;
+    }
+    _JMEST7735R_formatNumber(number, value, text);
+#if JMEST7735R_USE_BANDRENDER
+    if (display->isRecording) {
+        //
+        // the frame is repainted band by band, so the readout is drawn whole
+        // from what it will show once the frame is out
+        JMEST7735R_DrawOp_t op = {JMEST7735R_OP_READOUT};
+        op.frame = _JMEST7735R_numberField(number, text, &number->shownX);
+        op.data = number;
+        memcpy(number->shown, text, sizeof(text));
+        number->shownTextColor = number->textColor;
+        number->shownBgColor = number->bgColor;
+        number->isShown = TRUE;
+        _JMEST7735R_recordOp(display, &op);
+        return;
+    }
+#endif
+    _JMEST7735R_drawNumberField(display, number, text, FALSE);
+}
 
+void JMEST7735RNumber_invalidate(JMEST7735RNumber_t * number) {
+    if (NULL != number) {
+        number->isShown = FALSE;
+    }
+}
+
+uint16_t JMEST7735RFont_measure(const JMEST7735RFont_t * font, const char * string) {
+    uint16_t width = 0;
+    if (NULL != string) {
+        for (; '\0' != *string; string ++) {
+            JMEST7735RFontGlyph_t glyph;
+            if (_JMEST7735R_fontGlyph(font, *string, &glyph)) {
+                width += glyph.advance;
+            }
+        }
+    }
+    return width;
+}
+
+#pragma mark - default display
+void JMEST7735R_setAdapter(const JMEST7735RAdapter_t * adapter)
+{
+    JMEST7735RDisplay_setAdapter(JMEST7735R_DEFAULT_DISPLAY, adapter);
+}
+
+void JMEST7735R_init(void)
+{
+    //
+    // device port init
+    JMEST7735R_portInit();
+    JMEST7735RDisplay_init(JMEST7735R_DEFAULT_DISPLAY);
+}
+
+void JMEST7735R_resume(void)
+{
+    JMEST7735R_portInit();
+    JMEST7735RDisplay_resume(JMEST7735R_DEFAULT_DISPLAY);
+}
+
+void JMEST7735R_enterSleep(void)
+{
+    JMEST7735RDisplay_enterSleep(JMEST7735R_DEFAULT_DISPLAY);
+    JMEST7735R_IOEnterSleep(TRUE);
+}
+
+void JMEST7735R_exitSleep(void)
+{
+    JMEST7735R_IOEnterSleep(FALSE);
+    JMEST7735RDisplay_exitSleep(JMEST7735R_DEFAULT_DISPLAY);
+}
+
+void JMEST7735R_setRotation(JMEST7735R_ROTATION rotation, BOOL isMirrored)
+{
+    JMEST7735RDisplay_setRotation(JMEST7735R_DEFAULT_DISPLAY, rotation, isMirrored);
+}
+
+JMERect JMEST7735R_getBounds(void)
+{
+    return JMEST7735RDisplay_getBounds(JMEST7735R_DEFAULT_DISPLAY);
+}
+
+void JMEST7735R_setPixelFormat(JMEST7735R_IPF pixelFormat)
+{
+    JMEST7735RDisplay_setPixelFormat(JMEST7735R_DEFAULT_DISPLAY, pixelFormat);
+}
+
+BOOL JMEST7735R_pushClip(JMERect rect)
+{
+    return JMEST7735RDisplay_pushClip(JMEST7735R_DEFAULT_DISPLAY, rect);
+}
+
+void JMEST7735R_popClip(void)
+{
+    JMEST7735RDisplay_popClip(JMEST7735R_DEFAULT_DISPLAY);
+}
+
+void JMEST7735R_enterPartialMode(uint8_t top, uint8_t height)
+{
+    JMEST7735RDisplay_enterPartialMode(JMEST7735R_DEFAULT_DISPLAY, top, height);
+}
+
+void JMEST7735R_exitPartialMode(void)
+{
+    JMEST7735RDisplay_exitPartialMode(JMEST7735R_DEFAULT_DISPLAY);
+}
+
+void JMEST7735R_enterIdleMode(void)
+{
+    JMEST7735RDisplay_enterIdleMode(JMEST7735R_DEFAULT_DISPLAY);
+}
+
+void JMEST7735R_exitIdleMode(void)
+{
+    JMEST7735RDisplay_exitIdleMode(JMEST7735R_DEFAULT_DISPLAY);
+}
+
+void JMEST7735R_setScrollArea(uint8_t topFixed, uint8_t bottomFixed)
+{
+    JMEST7735RDisplay_setScrollArea(JMEST7735R_DEFAULT_DISPLAY, topFixed, bottomFixed);
+}
+
+void JMEST7735R_setScrollOffset(uint8_t offset)
+{
+    JMEST7735RDisplay_setScrollOffset(JMEST7735R_DEFAULT_DISPLAY, offset);
+}
+
+uint8_t JMEST7735R_getScrollOffset(void)
+{
+    return JMEST7735RDisplay_getScrollOffset(JMEST7735R_DEFAULT_DISPLAY);
+}
+
+void JMEST7735R_scroll(int16_t lines)
+{
+    JMEST7735RDisplay_scroll(JMEST7735R_DEFAULT_DISPLAY, lines);
+}
+
+void JMEST7735R_setCompletionCallback(JMEST7735RCompletion_t callback, void * context)
+{
+    JMEST7735RDisplay_setCompletionCallback(JMEST7735R_DEFAULT_DISPLAY, callback, context);
+}
+
+JMEST7735RFence_t JMEST7735R_fence(void)
+{
+    return JMEST7735RDisplay_fence(JMEST7735R_DEFAULT_DISPLAY);
+}
+
+BOOL JMEST7735R_isFenceDone(JMEST7735RFence_t fence)
+{
+    return JMEST7735RDisplay_isFenceDone(JMEST7735R_DEFAULT_DISPLAY, fence);
+}
+
+void JMEST7735R_waitFence(JMEST7735RFence_t fence)
+{
+    JMEST7735RDisplay_waitFence(JMEST7735R_DEFAULT_DISPLAY, fence);
+}
+
+void JMEST7735R_blockWriteDone(void)
+{
+    JMEST7735RDisplay_blockWriteDone(JMEST7735R_DEFAULT_DISPLAY);
+}
+
+void JMEST7735R_setFramebuffer(uint16_t * framebuffer)
+{
+    JMEST7735RDisplay_setFramebuffer(JMEST7735R_DEFAULT_DISPLAY, framebuffer);
+}
+
+void JMEST7735R_setGlyphCache(void * arena, uint16_t length)
+{
+    JMEST7735RDisplay_setGlyphCache(JMEST7735R_DEFAULT_DISPLAY, arena, length);
+}
+
+void JMEST7735R_refreshScreen(void)
+{
+    JMEST7735RDisplay_refreshScreen(JMEST7735R_DEFAULT_DISPLAY);
+}
+
+void JMEST7735R_beginFrame(uint16_t bgColor)
+{
+    JMEST7735RDisplay_beginFrame(JMEST7735R_DEFAULT_DISPLAY, bgColor);
+}
+
+BOOL JMEST7735R_endFrame(void)
+{
+    return JMEST7735RDisplay_endFrame(JMEST7735R_DEFAULT_DISPLAY);
+}
+
+void JMEST7735R_fillScreen(uint16_t color)
+{
+    JMEST7735RDisplay_fillScreen(JMEST7735R_DEFAULT_DISPLAY, color);
+}
+
+void JMEST7735R_drawLine(JMEPoint start, JMEPoint end, uint16_t color)
+{
+    JMEST7735RDisplay_drawLine(JMEST7735R_DEFAULT_DISPLAY, start, end, color);
+}
+
+void JMEST7735R_drawThickLine(JMEPoint start, JMEPoint end, uint8_t thickness, uint16_t color)
+{
+    JMEST7735RDisplay_drawThickLine(JMEST7735R_DEFAULT_DISPLAY, start, end, thickness, color);
+}
+
+void JMEST7735R_drawRect(JMERect frame, uint16_t color, BOOL fill)
+{
+    JMEST7735RDisplay_drawRect(JMEST7735R_DEFAULT_DISPLAY, frame, color, fill);
+}
+
+void JMEST7735R_drawBitmap(const uint16_t * image, JMERect frame, BOOL isHighLight)
+{
+    JMEST7735RDisplay_drawBitmap(JMEST7735R_DEFAULT_DISPLAY, image, frame, isHighLight);
+}
+
+void JMEST7735R_drawCompressedBitmap(const uint8_t * image, JMERect frame)
+{
+    JMEST7735RDisplay_drawCompressedBitmap(JMEST7735R_DEFAULT_DISPLAY, image, frame);
+}
+
+void JMEST7735R_drawIndexedBitmap(const uint8_t * image, JMERect frame, uint8_t bitsPerPixel, const uint16_t * palette)
+{
+    JMEST7735RDisplay_drawIndexedBitmap(JMEST7735R_DEFAULT_DISPLAY, image, frame, bitsPerPixel, palette);
+}
+
+void JMEST7735R_drawBinaryImage(const uint8_t * image, JMERect frame, uint16_t fgColor, uint16_t bgColor)
+{
+    JMEST7735RDisplay_drawBinaryImage(JMEST7735R_DEFAULT_DISPLAY, image, frame, fgColor, bgColor);
+}
+
+void JMEST7735R_drawBinaryImageStride(const uint8_t * image, JMERect frame, uint16_t stride, uint16_t fgColor, uint16_t bgColor)
+{
+    JMEST7735RDisplay_drawBinaryImageStride(JMEST7735R_DEFAULT_DISPLAY, image, frame, stride, fgColor, bgColor);
+}
+
+void JMEST7735R_drawBinaryIcon(const JMEMenuIcon_t * icon)
+{
+    JMEST7735RDisplay_drawBinaryIcon(JMEST7735R_DEFAULT_DISPLAY, icon);
+}
+
+void JMEST7735R_drawNumber(JMEPoint startPoint, uint16_t number, uint16_t textColor, uint16_t bgColor, uint8_t fontSize)
+{
+    JMEST7735RDisplay_drawNumber(JMEST7735R_DEFAULT_DISPLAY, startPoint, number, textColor, bgColor, fontSize);
+}
+
+void JMEST7735R_drawMenuIcon(const JMEMenuIcon_t * icon, BOOL isHighLight)
+{
+    JMEST7735RDisplay_drawMenuIcon(JMEST7735R_DEFAULT_DISPLAY, icon, isHighLight);
+}
+
+void JMEST7735R_drawString(JMEPoint startPoint, const char * string, uint16_t textColor, uint16_t bgColor, uint8_t fontSize)
+{
+    JMEST7735RDisplay_drawString(JMEST7735R_DEFAULT_DISPLAY, startPoint, string, textColor, bgColor, fontSize);
+}
+
+void JMEST7735R_drawText(JMEPoint startPoint, const char * string, const JMEST7735RFont_t * font, uint16_t textColor, uint16_t bgColor)
+{
+    JMEST7735RDisplay_drawText(JMEST7735R_DEFAULT_DISPLAY, startPoint, string, font, textColor, bgColor);
+}
+
+void JMEST7735R_updateNumber(JMEST7735RNumber_t * number, int32_t value)
+{
+    JMEST7735RDisplay_updateNumber(JMEST7735R_DEFAULT_DISPLAY, number, value);
+}
+
+uint16_t JMEST7735R_drawTextInRect(JMERect rect, const char * string, const JMEST7735RFont_t * font, uint16_t textColor, uint16_t bgColor)
+{
+    return JMEST7735RDisplay_drawTextInRect(JMEST7735R_DEFAULT_DISPLAY, rect, string, font, textColor, bgColor);
+}
+
+/*********************************************************************
+ * IMPLEMENT OF PRIVATE FUNCTIONS
+ */
+#pragma mark - private functions
+static inline void _JMEST7735R_HDReset(JMEST7735RDisplay_t * display)
+{
+    if (NULL == display->adapter->setReset) {
+        //
+        // reset line not wired to this panel
+        _JMEST7735R_SWReset(display);
+        return;
+    }
+    display->adapter->setReset(display->adapter->context, TRUE);
+    _JMEST7735R_delay(display, JMEST7735R_RESET_PULSE_MS);
+    display->adapter->setReset(display->adapter->context, FALSE);
+    _JMEST7735R_delay(display, JMEST7735R_RESET_SETTLE_MS);
+    _JMEST7735R_invalidateWindow(display);
+}
+
+static inline void _JMEST7735R_SWReset(JMEST7735RDisplay_t * display)
+{
+    _JMEST7735R_writeCommandGroup(display, JMEST7735R_SWReset, NULL, 0);
+    _JMEST7735R_delay(display, 120);
+    _JMEST7735R_invalidateWindow(display);
+}
+
+static inline void _JMEST7735R_setPixelFormat(JMEST7735RDisplay_t * display, JMEST7735R_IPF pixelFormat)
+{
+    _JMEST7735R_write_command(display, JMEST7735R_COLMOD);
+    _JMEST7735R_write_data(display, pixelFormat);
+    display->pixelFormat = pixelFormat;
+}
+
+/**
+ *  Forget the cached address window. Needed whenever the controller may have
+ *  lost or reinterpreted it: reset, sleep and MADCTL changes.
+ */
+static inline void _JMEST7735R_invalidateWindow(JMEST7735RDisplay_t * display)
+{
+    display->isColumnValid = FALSE;
+    display->isRowValid = FALSE;
+}
+
+/**
+ *  Interpret an init sequence in one bus transaction, released only while
+ *  waiting for a delay. A MADCTL entry drops the cached address window.
+ */
+static void _JMEST7735R_runSequence(JMEST7735RDisplay_t * display, const uint8_t * sequence, uint16_t length)
+{
+    const uint8_t * end = sequence + length;
+    _JMEST7735R_beginTransaction(display);
+    while (sequence < end) {
+        uint8_t cmd = *sequence ++;
+        uint8_t count = *sequence ++;
+        _JMEST7735R_write_command(display, cmd);
+        _JMEST7735R_write_params(display, sequence, count & ~JMEST7735R_SEQ_DELAY);
+        sequence += count & ~JMEST7735R_SEQ_DELAY;
+        if (JMEST7735R_MADCTL == cmd) {
+            display->madctl = *(sequence - 1);
+            _JMEST7735R_invalidateWindow(display);
+        } else if (JMEST7735R_COLMOD == cmd) {
+            display->pixelFormat = *(sequence - 1);
+        }
+        if (count & JMEST7735R_SEQ_DELAY) {
+            _JMEST7735R_endTransaction(display);
+            _JMEST7735R_delay(display, *sequence ++);
+            _JMEST7735R_beginTransaction(display);
+        }
+    }
+    _JMEST7735R_endTransaction(display);
+}
+
+static inline BOOL _JMEST7735R_setDrawWindow(JMEST7735RDisplay_t * display, JMERect rect) {
+    if (!JMERectIsEmpty(rect)) {
+        uint8_t x0 = rect.origin.x + display->frame.origin.x;
+        uint8_t x1 = x0 + rect.size.width - 1;
+        uint8_t y0 = rect.origin.y + display->frame.origin.y;
+        uint8_t y1 = y0 + rect.size.height - 1;
+        //
+        // column address set, skipped when the panel already has it
+        if (!display->isColumnValid || x0 != display->column[1] || x1 != display->column[3]) {
+            display->column[1] = x0;
+            display->column[3] = x1;
+            display->isColumnValid = TRUE;
+            _JMEST7735R_write_command(display, JMEST7735R_CASET);
+            _JMEST7735R_write_params(display, display->column, sizeof(display->column));
+        }
+        //
+        // row address set
+        if (!display->isRowValid || y0 != display->row[1] || y1 != display->row[3]) {
+            display->row[1] = y0;
+            display->row[3] = y1;
+            display->isRowValid = TRUE;
+            _JMEST7735R_write_command(display, JMEST7735R_RASET);
+            _JMEST7735R_write_params(display, display->row, sizeof(display->row));
+        }
+        return TRUE;
+    }
+    return FALSE;
+}
+
+/**
+ *  Window setup, RAMWR and the pixel data that follows all share one chip
+ *  select cycle, which _JMEST7735R_endMemoryWrite closes.
+ */
+static inline BOOL _JMEST7735R_beginMemoryWrite(JMEST7735RDisplay_t * display, JMERect rect)
+{
+    if (JMERectIsEmpty(rect) || !_JMEST7735R_isScanned(display, rect)) {
+        return FALSE;
+    }
+    _JMEST7735R_beginTransaction(display);
+    if (0 != display->scrollOffset) {
+        display->writeRect = rect;
+        _JMEST7735R_openSegment(display);
+        return TRUE;
+    }
+    _JMEST7735R_setDrawWindow(display, rect);
+    _JMEST7735R_write_command(display, JMEST7735R_RAMWR);
+    return TRUE;
+}
+
+/**
+ *  Open a window for the next rows of a memory write while the screen is
+ *  scrolled: as many rows as lie next to each other in frame memory. Rows of
+ *  the scroll area are `scrollOffset' further down, wrapping at its end.
+ */
+static void _JMEST7735R_openSegment(JMEST7735RDisplay_t * display)
+{
+    JMERect segment = display->writeRect;
+    int16_t top = display->scrollTop;
+    int16_t end = top + display->scrollHeight;
+    int16_t y = segment.origin.y;
+    if (y < top) {
+        segment.size.height = JMEMin(segment.size.height, top - y);
+    } else if (y < end) {
+        segment.origin.y = top + (y - top + display->scrollOffset) % display->scrollHeight;
+        segment.size.height = JMEMin(segment.size.height, JMEMin(end - y, end - segment.origin.y));
+    }
+    display->writeRect.origin.y += segment.size.height;
+    display->writeRect.size.height -= segment.size.height;
+    display->segmentPixels = segment.size.width * segment.size.height;
+    _JMEST7735R_setDrawWindow(display, segment);
+    _JMEST7735R_write_command(display, JMEST7735R_RAMWR);
+}
+
+/**
+ *  How many of `count' pixels go to the current window, moving on to the
+ *  next one when it is full. All of them unless the screen is scrolled.
+ */
+static inline uint16_t _JMEST7735R_segmentSpan(JMEST7735RDisplay_t * display, uint16_t count)
+{
+    if (0 == display->scrollOffset) {
+        return count;
+    }
+    if (0 == display->segmentPixels) {
+        _JMEST7735R_releaseHeldColor(display);
+#if JMEST7735R_USE_ASYNC
+        //
+        // the pixels queued so far belong to the old window
+        _JMEST7735R_submitLine(display, FALSE);
+        _JMEST7735R_waitTransfer(display);
+#endif
+        _JMEST7735R_openSegment(display);
+    }
+    count = JMEMin(count, display->segmentPixels);
+    display->segmentPixels -= count;
+    return count;
+}
+
+/**
+ *  Whether any row of `rect' is on screen: all of them in normal mode, those
+ *  of the partial area in partial mode.
+ */
+static inline BOOL _JMEST7735R_isScanned(JMEST7735RDisplay_t * display, JMERect rect)
+{
+    return 0 == display->partialHeight ||
+    (rect.origin.y < display->partialTop + display->partialHeight &&
+     rect.origin.y + rect.size.height > display->partialTop);
+}
+
+/**
+ *  The rows of `rect' that are on screen, see _JMEST7735R_isScanned.
+ */
+static inline JMERect _JMEST7735R_scannedRect(JMEST7735RDisplay_t * display, JMERect rect)
+{
+    if (0 != display->partialHeight) {
+        rect = JMERectIntersection(rect, JMERectMake(0, display->partialTop,
+                                                     display->bounds.size.width, display->partialHeight));
+    }
+    return rect;
+}
+
+/**
+ *  Program the address order of the display's rotation and move the frame
+ *  into the rotated address space. With MV the column counter runs along
+ *  the GRAM lines, so width and height swap; a mirrored counter counts from
+ *  the far end of the memory.
+ */
+static void _JMEST7735R_writeRotation(JMEST7735RDisplay_t * display)
+{
+    const uint8_t order = JMEST7735R_MADCTL_MY | JMEST7735R_MADCTL_MX | JMEST7735R_MADCTL_MV;
+    uint8_t madctl = kJMEST7735RRotationMADCTL[display->rotation];
+    JMERect native = display->nativeFrame;
+    uint8_t x, y;
+    if (display->isMirrored) {
+        madctl ^= (madctl & JMEST7735R_MADCTL_MV) ? JMEST7735R_MADCTL_MY : JMEST7735R_MADCTL_MX;
+    }
+    madctl |= display->madctl & ~order;
+    //
+    // the native frame is given in MX|MY order
+    x = (madctl & JMEST7735R_MADCTL_MX) ? native.origin.x : JMEST7735R_GRAM_COLUMNS - native.origin.x - native.size.width;
+    y = (madctl & JMEST7735R_MADCTL_MY) ? native.origin.y : JMEST7735R_GRAM_LINES - native.origin.y - native.size.height;
+    if (madctl & JMEST7735R_MADCTL_MV) {
+        display->frame = JMERectMake(y, x, native.size.height, native.size.width);
+    } else {
+        display->frame = JMERectMake(x, y, native.size.width, native.size.height);
+    }
+    display->bounds = JMERectMake(0, 0, display->frame.size.width, display->frame.size.height);
+    if (madctl != display->madctl) {
+        _JMEST7735R_writeCommandGroup(display, JMEST7735R_MADCTL, &madctl, 1);
+        display->madctl = madctl;
+        _JMEST7735R_invalidateWindow(display);
+    }
+}
+
+static void _JMEST7735R_writeScrollStart(JMEST7735RDisplay_t * display)
+{
+    uint16_t start = display->frame.origin.y + display->scrollTop + display->scrollOffset;
+    uint8_t params[2];
+    params[0] = start >> 8;
+    params[1] = (uint8_t)start;
+    _JMEST7735R_writeCommandGroup(display, JMEST7735R_VSCSAD, params, sizeof(params));
+}
+
+static inline void _JMEST7735R_writeColor(JMEST7735RDisplay_t * display, uint16_t color, uint16_t count)
+{
+    while (count > 0) {
+        uint16_t pixels = _JMEST7735R_segmentSpan(display, count);
+        count -= pixels;
+        if (JMEST7735R_IPF_16 != display->pixelFormat) {
+            _JMEST7735R_packColor(display, color, pixels);
+            continue;
+        }
+#if JMEST7735R_USE_ASYNC
+        while (pixels --) {
+            _JMEST7735R_queuePixel(display, color);
+        }
+#else
+        display->adapter->fillRepeat(display->adapter->context, color, pixels);
+#endif
+    }
+}
+
+static inline void _JMEST7735R_writePixelData(JMEST7735RDisplay_t * display, const uint16_t * colorArray, uint16_t count)
+{
+    if (JMEST7735R_IPF_16 != display->pixelFormat) {
+        while (count > 0) {
+            uint16_t pixels = _JMEST7735R_segmentSpan(display, count);
+            _JMEST7735R_packPixelData(display, colorArray, pixels);
+            colorArray += pixels;
+            count -= pixels;
+        }
+        return;
+    }
+#if JMEST7735R_USE_ASYNC
+    while (count > 0) {
+        uint16_t pixels = _JMEST7735R_segmentSpan(display, count);
+        count -= pixels;
+        while (pixels --) {
+            _JMEST7735R_queuePixel(display, *colorArray ++);
+        }
+    }
+#else
+    while (count > 0) {
+        //
+        // repack into wire order a block at a time
+        uint8_t block[JMEST7735R_BLOCK_PIXELS * 2];
+        uint16_t pixels = _JMEST7735R_segmentSpan(display, JMEMin(count, JMEST7735R_BLOCK_PIXELS));
+        for (uint16_t i = 0; i < pixels; i ++) {
+            block[2 * i] = (uint8_t)(colorArray[i] >> 8);
+            block[2 * i + 1] = (uint8_t)colorArray[i];
+        }
+        display->adapter->writeBlock(display->adapter->context, block, pixels * 2);
+        colorArray += pixels;
+        count -= pixels;
+    }
+#endif
+}
+
+static inline void _JMEST7735R_writePixelBytes(JMEST7735RDisplay_t * display, const uint8_t * bytes, uint16_t count)
+{
+    while (count > 0) {
+        uint16_t pixels = _JMEST7735R_segmentSpan(display, count);
+        count -= pixels;
+        if (JMEST7735R_IPF_16 != display->pixelFormat) {
+            _JMEST7735R_packPixelBytes(display, bytes, pixels);
+            bytes += pixels * 2;
+            continue;
+        }
+#if JMEST7735R_USE_ASYNC
+        while (pixels --) {
+            _JMEST7735R_queuePixel(display, (bytes[0] << 8) | bytes[1]);
+            bytes += 2;
+        }
+#else
+        display->adapter->writeBlock(display->adapter->context, bytes, pixels * 2);
+        bytes += pixels * 2;
+#endif
+    }
+}
+
+static inline void _JMEST7735R_endMemoryWrite(JMEST7735RDisplay_t * display)
+{
+    _JMEST7735R_releaseHeldColor(display);
+#if JMEST7735R_USE_ASYNC
+    //
+    // the panel is deselected by the completion of the last block
+    _JMEST7735R_submitLine(display, TRUE);
+#else
+    _JMEST7735R_endTransaction(display);
+#endif
+}
+
+/**
+ *  Packing kernels for the 12- and 18-bit interface formats. Colors stay
+ *  RGB565 up to the panel layer and are narrowed or widened on the way to
+ *  the bus. 12-bit pairs may straddle calls: the first pixel of an
+ *  unfinished pair is held until the next one arrives or the window ends.
+ */
+static inline void _JMEST7735R_pack12(uint16_t first, uint16_t second, uint8_t * out)
+{
+    out[0] = (uint8_t)(((first >> 8) & 0xF0) | ((first >> 7) & 0x0F));
+    out[1] = (uint8_t)(((first << 3) & 0xF0) | (second >> 12));
+    out[2] = (uint8_t)(((second >> 3) & 0xF0) | ((second >> 1) & 0x0F));
+}
+
+static inline void _JMEST7735R_pack18(uint16_t color, uint8_t * out)
+{
+    out[0] = (uint8_t)(color >> 8) & 0xF8;
+    out[1] = (uint8_t)(color >> 3) & 0xFC;
+    out[2] = (uint8_t)(color << 3);
+}
+
+static void _JMEST7735R_writePacked(JMEST7735RDisplay_t * display, const uint8_t * bytes, uint16_t length)
+{
+#if JMEST7735R_USE_ASYNC
+    while (length > 0) {
+        uint16_t count = JMEMin(length, JMEST7735R_ASYNC_LINE_BYTES - display->lineCount);
+        memcpy(display->line[display->lineIndex] + display->lineCount, bytes, count);
+        display->lineCount += count;
+        bytes += count;
+        length -= count;
+        if (display->lineCount >= JMEST7735R_ASYNC_LINE_BYTES) {
+            _JMEST7735R_submitLine(display, FALSE);
+        }
+    }
+#else
+    display->adapter->writeBlock(display->adapter->context, bytes, length);
+#endif
+}
+
+/**
+ *  Fill: one 3-byte unit is repeated through the block, which then goes out
+ *  as often as needed.
+ */
+static void _JMEST7735R_packColor(JMEST7735RDisplay_t * display, uint16_t color, uint16_t count)
+{
+    uint8_t block[JMEST7735R_PACK_BLOCK_UNITS * 3];
+    uint16_t units;
+    uint8_t blockUnits;
+    if (JMEST7735R_IPF_18 == display->pixelFormat) {
+        _JMEST7735R_pack18(color, block);
+        units = count;
+    } else {
+        if (display->isColorHeld && count > 0) {
+            _JMEST7735R_pack12(display->heldColor, color, block);
+            _JMEST7735R_writePacked(display, block, 3);
+            display->isColorHeld = FALSE;
+            count --;
+        }
+        _JMEST7735R_pack12(color, color, block);
+        units = count >> 1;
+    }
+    blockUnits = JMEMin(units, JMEST7735R_PACK_BLOCK_UNITS);
+    for (uint8_t i = 1; i < blockUnits; i ++) {
+        memcpy(block + i * 3, block, 3);
+    }
+    while (units > 0) {
+        uint8_t send = JMEMin(units, blockUnits);
+        _JMEST7735R_writePacked(display, block, send * 3);
+        units -= send;
+    }
+    if (JMEST7735R_IPF_12 == display->pixelFormat && (count & 1)) {
+        display->heldColor = color;
+        display->isColorHeld = TRUE;
+    }
+}
+
+/**
+ *  Blit: RGB565 values, e.g. bitmaps and the framebuffer.
+ */
+static void _JMEST7735R_packPixelData(JMEST7735RDisplay_t * display, const uint16_t * colorArray, uint16_t count)
+{
+    uint8_t block[JMEST7735R_PACK_BLOCK_UNITS * 3];
+    uint8_t fill = 0;
+    if (JMEST7735R_IPF_18 == display->pixelFormat) {
+        while (count --) {
+            _JMEST7735R_pack18(*colorArray ++, block + fill);
+            fill += 3;
+            if (fill == sizeof(block)) {
+                _JMEST7735R_writePacked(display, block, fill);
+                fill = 0;
+            }
+        }
+    } else {
+        if (display->isColorHeld && count > 0) {
+            _JMEST7735R_pack12(display->heldColor, *colorArray ++, block);
+            display->isColorHeld = FALSE;
+            fill = 3;
+            count --;
+        }
+        for (; count >= 2; count -= 2, colorArray += 2) {
+            _JMEST7735R_pack12(colorArray[0], colorArray[1], block + fill);
+            fill += 3;
+            if (fill == sizeof(block)) {
+                _JMEST7735R_writePacked(display, block, fill);
+                fill = 0;
+            }
+        }
+        if (count > 0) {
+            display->heldColor = *colorArray;
+            display->isColorHeld = TRUE;
+        }
+    }
+    if (fill > 0) {
+        _JMEST7735R_writePacked(display, block, fill);
+    }
+}
+
+/**
+ *  Wire-order RGB565 bytes, as expanded by the text, monochrome, indexed
+ *  and compressed image paths and kept in the glyph cache.
+ */
+static void _JMEST7735R_packPixelBytes(JMEST7735RDisplay_t * display, const uint8_t * bytes, uint16_t count)
+{
+    uint8_t block[JMEST7735R_PACK_BLOCK_UNITS * 3];
+    uint8_t fill = 0;
+    if (JMEST7735R_IPF_18 == display->pixelFormat) {
+        //
+        // components are already in place, only the green field moves
+        for (; count > 0; count --, bytes += 2) {
+            block[fill ++] = bytes[0] & 0xF8;
+            block[fill ++] = (uint8_t)((bytes[0] << 5) | ((bytes[1] >> 3) & 0x1C));
+            block[fill ++] = (uint8_t)(bytes[1] << 3);
+            if (fill == sizeof(block)) {
+                _JMEST7735R_writePacked(display, block, fill);
+                fill = 0;
+            }
+        }
+    } else {
+        if (display->isColorHeld && count > 0) {
+            _JMEST7735R_pack12(display->heldColor, (bytes[0] << 8) | bytes[1], block);
+            display->isColorHeld = FALSE;
+            bytes += 2;
+            fill = 3;
+            count --;
+        }
+        for (; count >= 2; count -= 2, bytes += 4) {
+            block[fill ++] = (uint8_t)((bytes[0] & 0xF0) | ((bytes[0] << 1) & 0x0E) | (bytes[1] >> 7));
+            block[fill ++] = (uint8_t)(((bytes[1] << 3) & 0xF0) | (bytes[2] >> 4));
+            block[fill ++] = (uint8_t)(((bytes[2] << 5) & 0xE0) | ((bytes[3] >> 3) & 0x10) | ((bytes[3] >> 1) & 0x0F));
+            if (fill == sizeof(block)) {
+                _JMEST7735R_writePacked(display, block, fill);
+                fill = 0;
+            }
+        }
+        if (count > 0) {
+            display->heldColor = (bytes[0] << 8) | bytes[1];
+            display->isColorHeld = TRUE;
+        }
+    }
+    if (fill > 0) {
+        _JMEST7735R_writePacked(display, block, fill);
+    }
+}
+
+/**
+ *  Send a held 12-bit pixel on its own: the controller stores a pixel once
+ *  its 12 bits have arrived, the padding of the second byte is dropped.
+ */
+static void _JMEST7735R_releaseHeldColor(JMEST7735RDisplay_t * display)
+{
+    if (display->isColorHeld) {
+        uint8_t unit[3];
+        _JMEST7735R_pack12(display->heldColor, 0, unit);
+        _JMEST7735R_writePacked(display, unit, 2);
+        display->isColorHeld = FALSE;
+    }
+}
+
+#if JMEST7735R_USE_ASYNC
+/**
+ *  Double buffered transfer. Pixels are packed big-endian into the fill
+ *  buffer; a full buffer is handed to the adapter as soon as the previous
+ *  block has left the bus, so the CPU only waits when it is a whole line
+ *  ahead of the transfer.
+ */
+static inline void _JMEST7735R_waitTransfer(JMEST7735RDisplay_t * display)
+{
+    if (NULL == display->adapter->waitBlock) {
+        while (display->isInFlight) {
+        }
+        return;
+    }
+    //
+    // waitBlock also orders the completion handler before what follows
+    do {
+        display->adapter->waitBlock(display->adapter->context);
+    } while (display->isInFlight);
+}
+
+static inline void _JMEST7735R_queuePixel(JMEST7735RDisplay_t * display, uint16_t color)
+{
+    uint8_t * data = display->line[display->lineIndex] + display->lineCount;
+    data[0] = (uint8_t)(color >> 8);
+    data[1] = (uint8_t)color;
+    display->lineCount += 2;
+    if (display->lineCount >= JMEST7735R_ASYNC_LINE_BYTES) {
+        _JMEST7735R_submitLine(display, FALSE);
+    }
+}
+
+static void _JMEST7735R_submitLine(JMEST7735RDisplay_t * display, BOOL isLast)
+{
+    const uint8_t * data = display->line[display->lineIndex];
+    uint16_t length = display->lineCount;
+
+    _JMEST7735R_waitTransfer(display);
+    if (0 == length) {
+        if (isLast) {
+            _JMEST7735R_endTransaction(display);
+        }
+        return;
+    }
+    display->lineIndex ^= 1;
+    display->lineCount = 0;
+    display->isReleasePending = isLast;
+    display->isInFlight = TRUE;
+    display->submitted ++;
+    if (NULL != display->adapter->startBlock) {
+        display->adapter->startBlock(display->adapter->context, display, data, length);
+    } else {
+        display->adapter->writeBlock(display->adapter->context, data, length);
+        JMEST7735RDisplay_blockWriteDone(display);
+    }
+}
+#endif
+
+/**
+ *  Part of `rect' a draw call may touch: inside the clip and, while rendering
+ *  into RAM, inside the target. Pixels for the panel are further limited to
+ *  the rows it scans; RAM keeps every row for when partial mode ends.
+ */
+static JMERect _JMEST7735R_visibleRect(JMEST7735RDisplay_t * display, JMERect rect)
+{
+    rect = JMERectIntersection(rect, display->clip);
+#if JMEST7735R_USE_RAMTARGET
+    if (NULL != display->target) {
+        return JMERectIntersection(rect, display->targetRect);
+    }
+#endif
+    return _JMEST7735R_scannedRect(display, rect);
+}
+
+/**
+ *  Walk a clipped pixel stream: of the next `count' pixels, returns how many
+ *  are used up and sets `send' to the visible ones, `skip' pixels in. A run
+ *  never crosses a row end, except rows above or below the visible part,
+ *  which are skipped together.
+ */
+static uint16_t _JMEST7735R_clipRun(JMEST7735RDisplay_t * display, uint16_t count, uint16_t * skip, uint16_t * send)
+{
+    const JMERect * source = &display->sourceRect;
+    const JMERect * visible = &display->visibleRect;
+    int16_t x = display->sourceX;
+    int16_t y = display->sourceY;
+    uint16_t run = source->origin.x + source->size.width - x;
+    uint32_t offset;
+
+    *skip = 0;
+    *send = 0;
+    if (y < visible->origin.y) {
+        run += (visible->origin.y - y - 1) * source->size.width;
+    } else if (y >= visible->origin.y + visible->size.height) {
+        run = count;
+    } else {
+        int16_t from = JMEMax(x, visible->origin.x);
+        int16_t to = JMEMin(x + JMEMin(run, count), visible->origin.x + visible->size.width);
+        if (from < to) {
+            *skip = from - x;
+            *send = to - from;
+        }
+    }
+    run = JMEMin(run, count);
+    offset = (uint32_t)(x - source->origin.x) + run;
+    display->sourceX = source->origin.x + offset % source->size.width;
+    display->sourceY = y + offset / source->size.width;
+    return run;
+}
+
+/**
+ *  Pixel stream. Every drawing function opens a stream over its frame, pushes
+ *  the pixels in row-major order and closes it. The stream goes straight to
+ *  the panel, or into the framebuffer when one is attached.
+ */
+static BOOL _JMEST7735R_beginPixels(JMEST7735RDisplay_t * display, JMERect rect)
+{
+    JMERect visible = _JMEST7735R_visibleRect(display, rect);
+    if (JMERectIsEmpty(visible)) {
+        return FALSE;
+    }
+    display->isStreamClipped = !JMERectEqualToRect(visible, rect);
+    display->sourceRect = rect;
+    display->visibleRect = visible;
+    display->sourceX = rect.origin.x;
+    display->sourceY = rect.origin.y;
+#if JMEST7735R_USE_RAMTARGET
+    if (NULL != display->target) {
+        display->streamRect = visible;
+        display->streamX = visible.origin.x;
+        display->streamY = visible.origin.y;
+        return TRUE;
+    }
+#endif
+    return _JMEST7735R_beginMemoryWrite(display, visible);
+}
+
+/**
+ *  The push functions take the pixels of the whole stream frame. In a clipped
+ *  stream only the visible part of each row goes on to the send functions,
+ *  which feed the framebuffer or the panel.
+ */
+static void _JMEST7735R_pushColor(JMEST7735RDisplay_t * display, uint16_t color, uint16_t count)
+{
+    while (display->isStreamClipped && count > 0) {
+        uint16_t skip, send;
+        count -= _JMEST7735R_clipRun(display, count, &skip, &send);
+        _JMEST7735R_sendColor(display, color, send);
+    }
+    _JMEST7735R_sendColor(display, color, count);
+}
+
+static void _JMEST7735R_pushPixels(JMEST7735RDisplay_t * display, const uint16_t * colorArray, uint16_t count)
+{
+    while (display->isStreamClipped && count > 0) {
+        uint16_t skip, send, run = _JMEST7735R_clipRun(display, count, &skip, &send);
+        _JMEST7735R_sendPixels(display, colorArray + skip, send);
+        colorArray += run;
+        count -= run;
+    }
+    _JMEST7735R_sendPixels(display, colorArray, count);
+}
+
+static void _JMEST7735R_pushPixelBytes(JMEST7735RDisplay_t * display, const uint8_t * bytes, uint16_t count)
+{
+    while (display->isStreamClipped && count > 0) {
+        uint16_t skip, send, run = _JMEST7735R_clipRun(display, count, &skip, &send);
+        _JMEST7735R_sendPixelBytes(display, bytes + skip * 2, send);
+        bytes += run * 2;
+        count -= run;
+    }
+    _JMEST7735R_sendPixelBytes(display, bytes, count);
+}
+
+static void _JMEST7735R_sendColor(JMEST7735RDisplay_t * display, uint16_t color, uint16_t count)
+{
+#if JMEST7735R_USE_RAMTARGET
+    if (NULL != display->target) {
+        while (count --) {
+            _JMEST7735R_storePixel(display, color);
+        }
+        return;
+    }
+#endif
+    _JMEST7735R_writeColor(display, color, count);
+}
+
+static void _JMEST7735R_sendPixels(JMEST7735RDisplay_t * display, const uint16_t * colorArray, uint16_t count)
+{
+#if JMEST7735R_USE_RAMTARGET
+    if (NULL != display->target) {
+        while (count --) {
+            _JMEST7735R_storePixel(display, *colorArray ++);
+        }
+        return;
+    }
+#endif
+    _JMEST7735R_writePixelData(display, colorArray, count);
+}
+
+/**
+ *  Send `count' pixels stored big-endian, the order they take on the wire.
+ */
+static void _JMEST7735R_sendPixelBytes(JMEST7735RDisplay_t * display, const uint8_t * bytes, uint16_t count)
+{
+#if JMEST7735R_USE_RAMTARGET
+    if (NULL != display->target) {
+        while (count --) {
+            _JMEST7735R_storePixel(display, (bytes[0] << 8) | bytes[1]);
+            bytes += 2;
+        }
+        return;
+    }
+#endif
+    _JMEST7735R_writePixelBytes(display, bytes, count);
+}
+
+static void _JMEST7735R_endPixels(JMEST7735RDisplay_t * display)
+{
+#if JMEST7735R_USE_RAMTARGET
+    if (NULL != display->target) {
+#if JMEST7735R_USE_FRAMEBUFFER
+        if (display->target == display->framebuffer) {
+            _JMEST7735R_invalidate(display, display->streamRect);
+        }
+#endif
+        return;
+    }
+#endif
+    _JMEST7735R_endMemoryWrite(display);
+}
+
+/**
+ *  For sources that can be read from any row and column: the caller reads
+ *  only the returned visible part and pushes it as the whole stream.
+ */
+static JMERect _JMEST7735R_cropStream(JMEST7735RDisplay_t * display)
+{
+    display->isStreamClipped = FALSE;
+    return display->visibleRect;
+}
+
+static void _JMEST7735R_buildMonoTable(JMEST7735R_MonoTable_t * table, uint16_t fgColor, uint16_t bgColor)
+{
+    table->fgColor = fgColor;
+    table->bgColor = bgColor;
+    for (uint8_t n = 0; n < 16; n ++) {
+        for (uint8_t k = 0; k < 4; k ++) {
+            uint16_t color = (n & JMEBit(3 - k)) ? fgColor : bgColor;
+            table->nibble[n][2 * k] = (uint8_t)(color >> 8);
+            table->nibble[n][2 * k + 1] = (uint8_t)color;
+        }
+    }
+#if JMEST7735R_USE_VECTOR
+    for (uint8_t k = 0; k < 8; k ++) {
+        table->fgLanes[k] = (uint16_t)((fgColor >> 8) | (fgColor << 8));
+        table->bgLanes[k] = (uint16_t)((bgColor >> 8) | (bgColor << 8));
+    }
+#endif
+}
+
+/**
+ *  Expand the first `count' pixels of a 1-bpp source byte to wire order.
+ */
+static inline void _JMEST7735R_expandByte(const JMEST7735R_MonoTable_t * table, uint8_t data, uint8_t count, uint8_t * out)
+{
+#if JMEST7735R_USE_VECTOR
+    if (8 == count) {
+        const JMEST7735R_Vector_t bits = {0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01};
+        JMEST7735R_Vector_t lanes = (JMEST7735R_Vector_t)((bits & data) != 0);
+        JMEST7735R_Vector_t pixels = (table->fgLanes & lanes) | (table->bgLanes & ~lanes);
+        memcpy(out, &pixels, 16);
+        return;
+    }
+#endif
+    memcpy(out, table->nibble[data >> 4], JMEMin(count, 4) * 2);
+    if (count > 4) {
+        memcpy(out + 8, table->nibble[data & 0x0F], (count - 4) * 2);
+    }
+}
+
+/**
+ *  Push a 1-bpp image into the open pixel stream: `height' rows of `width'
+ *  pixels from source column `column' on, leftmost pixel in the most
+ *  significant bit, rows `stride' bytes apart. Every source pixel becomes a
+ *  `scale' x `scale' square. Padding bits at the end of a row are never sent.
+ */
+static void _JMEST7735R_pushMono(JMEST7735RDisplay_t * display, const JMEST7735R_MonoTable_t * table, const uint8_t * image,
+                                 uint8_t column, uint16_t stride, uint8_t width, uint8_t height, uint8_t scale)
+{
+    uint8_t block[JMEST7735R_MONO_BLOCK_PIXELS * 2];
+    uint8_t fill = 0;
+    uint8_t shift = column & 7;
+
+    image += column >> 3;
+    for (uint8_t row = 0; row < height; row ++, image += stride) {
+        for (uint8_t repeat = 0; repeat < scale; repeat ++) {
+            const uint8_t * source = image;
+            uint8_t left = width;
+            while (left > 0) {
+                //
+                // a row starting inside a byte takes each byte's tail and the
+                // head of the next one
+                uint8_t data = (uint8_t)(*source ++ << shift);
+                uint8_t count = JMEMin(left, 8);
+                if (count > 8 - shift) {
+                    data |= *source >> (8 - shift);
+                }
+                if (1 == scale) {
+                    _JMEST7735R_expandByte(table, data, count, block + fill);
+                    fill += count * 2;
+                } else {
+                    for (uint8_t bit = 0; bit < count; bit ++, data <<= 1) {
+                        const uint8_t * pixel = table->nibble[(data & 0x80) ? 0x0F : 0x00];
+                        for (uint8_t i = 0; i < scale; i ++) {
+                            block[fill ++] = pixel[0];
+                            block[fill ++] = pixel[1];
+                            if (fill == sizeof(block)) {
+                                _JMEST7735R_pushPixelBytes(display, block, JMEST7735R_MONO_BLOCK_PIXELS);
+                                fill = 0;
+                            }
+                        }
+                    }
+                }
+                if (fill + 16 > sizeof(block)) {
+                    _JMEST7735R_pushPixelBytes(display, block, fill >> 1);
+                    fill = 0;
+                }
+                left -= count;
+            }
+        }
+    }
+    if (fill > 0) {
+        _JMEST7735R_pushPixelBytes(display, block, fill >> 1);
+    }
+}
+
+/**
+ *  Draw one glyph of a built-in font: `image' is its 1-bpp bitmap, one byte
+ *  per row, `size' its unscaled size. Served from the glyph cache when the
+ *  display has one and the scaled glyph fits a slot.
+ */
+static void _JMEST7735R_drawGlyph(JMEST7735RDisplay_t * display, const JMEST7735R_MonoTable_t * table, JMERect frame,
+                                  uint8_t font, uint8_t code, const uint8_t * image, JMESize size, uint8_t fontSize)
+{
+    if (_JMEST7735R_beginPixels(display, frame)) {
+#if JMEST7735R_USE_GLYPHCACHE
+        JMEST7735R_Glyph_t * glyph = _JMEST7735R_cachedGlyph(display, table, font, code, image, size, fontSize);
+        if (NULL != glyph) {
+            _JMEST7735R_pushPixelBytes(display, glyph->pixels, frame.size.width * frame.size.height);
+            _JMEST7735R_endPixels(display);
+            return;
+        }
+#endif
+        _JMEST7735R_pushMono(display, table, image, 0, 1, size.width, size.height, fontSize);
+        _JMEST7735R_endPixels(display);
+    }
+}
+
+static void _JMEST7735R_flushBlock(JMEST7735RDisplay_t * display, JMEST7735R_PixelBlock_t * block)
+{
+    if (block->fill > 0) {
+        _JMEST7735R_pushPixelBytes(display, block->bytes, block->fill >> 1);
+        block->fill = 0;
+    }
+}
+
+/**
+ *  Append `count' background pixels; long spans are sent as a fill.
+ */
+static void _JMEST7735R_blockFill(JMEST7735RDisplay_t * display, JMEST7735R_PixelBlock_t * block,
+                                  const JMEST7735R_MonoTable_t * table, uint16_t count)
+{
+    if (count >= JMEST7735R_FILL_SPAN_PIXELS) {
+        _JMEST7735R_flushBlock(display, block);
+        _JMEST7735R_pushColor(display, table->bgColor, count);
+        return;
+    }
+    while (count --) {
+        if (block->fill == sizeof(block->bytes)) {
+            _JMEST7735R_flushBlock(display, block);
+        }
+        block->bytes[block->fill ++] = table->nibble[0][0];
+        block->bytes[block->fill ++] = table->nibble[0][1];
+    }
+}
+
+/**
+ *  Append columns `from' to `to' (excluded) of a 1-bpp row drawn at `scale'.
+ */
+static void _JMEST7735R_blockMono(JMEST7735RDisplay_t * display, JMEST7735R_PixelBlock_t * block, const JMEST7735R_MonoTable_t * table,
+                                  const uint8_t * source, uint16_t from, uint16_t to, uint8_t scale)
+{
+    if (1 == scale && 0 == (from & 0x07)) {
+        //
+        // byte aligned: whole source bytes through the expansion table
+        for (source += from >> 3; from < to; from += 8) {
+            uint8_t count = JMEMin(to - from, 8);
+            if (block->fill + 16 > sizeof(block->bytes)) {
+                _JMEST7735R_flushBlock(display, block);
+            }
+            _JMEST7735R_expandByte(table, *source ++, count, block->bytes + block->fill);
+            block->fill += count * 2;
+        }
+    } else {
+        uint16_t bit = from / scale;
+        uint8_t phase = from % scale;
+        for (; from < to; from ++) {
+            const uint8_t * pixel = table->nibble[(source[bit >> 3] & (0x80 >> (bit & 0x07))) ? 0x0F : 0x00];
+            if (block->fill == sizeof(block->bytes)) {
+                _JMEST7735R_flushBlock(display, block);
+            }
+            block->bytes[block->fill ++] = pixel[0];
+            block->bytes[block->fill ++] = pixel[1];
+            if (++ phase == scale) {
+                phase = 0;
+                bit ++;
+            }
+        }
+    }
+}
+
+/**
+ *  Look up `character', `font' NULL is the built-in 8x12 ASCII font.
+ */
+static BOOL _JMEST7735R_fontGlyph(const JMEST7735RFont_t * font, char character, JMEST7735RFontGlyph_t * glyph)
+{
+    if (NULL == font) {
+        uint8_t index = (uint8_t)character - 32;
+        if (index >= 95) {
+            return FALSE;
+        }
+        glyph->offset = index * JMEST7735R_ASCIISIZE.height;
+        glyph->width = JMEST7735R_ASCIISIZE.width;
+        glyph->height = JMEST7735R_ASCIISIZE.height;
+        glyph->left = 0;
+        glyph->top = 0;
+        glyph->advance = JMEST7735R_ASCIISIZE.width;
+    } else {
+        uint8_t index = (uint8_t)character - font->firstCode;
+        if (index >= font->glyphCount) {
+            return FALSE;
+        }
+        *glyph = font->glyphs[index];
+    }
+    return TRUE;
+}
+
+/**
+ *  Append columns `from' to `to' (excluded) of glyph row `row', both in
+ *  pixels at `scale': margins and blank rows as background, the inked box
+ *  from the atlas.
+ */
+static void _JMEST7735R_blockGlyphRow(JMEST7735RDisplay_t * display, JMEST7735R_PixelBlock_t * block, const JMEST7735R_MonoTable_t * table,
+                                      const uint8_t * atlas, const JMEST7735RFontGlyph_t * glyph, uint8_t row,
+                                      uint16_t from, uint16_t to, uint8_t scale)
+{
+    uint16_t left = glyph->left * scale;
+    uint16_t right = left + glyph->width * scale;
+    if (0 == glyph->width || row < glyph->top || row >= glyph->top + glyph->height) {
+        _JMEST7735R_blockFill(display, block, table, to - from);
+        return;
+    }
+    if (from < left) {
+        _JMEST7735R_blockFill(display, block, table, JMEMin(to, left) - from);
+        from = left;
+    }
+    if (from < to && from < right) {
+        const uint8_t * source = atlas + glyph->offset + (row - glyph->top) * JMEST7735R_BINARY_STRIDE(glyph->width);
+        _JMEST7735R_blockMono(display, block, table, source, from - left, JMEMin(to, right) - left, scale);
+        from = right;
+    }
+    if (from < to) {
+        _JMEST7735R_blockFill(display, block, table, to - from);
+    }
+}
+
+/**
+ *  Draw `length' characters as one line with its top-left corner at (x, y),
+ *  cut to `clip'. The line gets a single window; every scanline streams the
+ *  matching glyph row of each character in turn.
+ */
+static void _JMEST7735R_drawTextRun(JMEST7735RDisplay_t * display, const JMEST7735R_MonoTable_t * table, const JMEST7735RFont_t * font,
+                                    const char * string, uint16_t length, int16_t x, int16_t y, JMERect clip, uint8_t scale)
+{
+    const uint8_t * atlas = (NULL != font) ? font->atlas : kJME_ASCII8x12_Table;
+    int16_t height = ((NULL != font) ? font->lineHeight : JMEST7735R_ASCIISIZE.height) * scale;
+    int16_t width = 0;
+    int16_t x0, x1, y0, y1;
+    JMEST7735R_PixelBlock_t block;
+#if JMEST7735R_USE_GLYPHCACHE
+    JMEST7735R_Glyph_t * cached[JMEST7735R_RUN_CACHED_GLYPHS];
+#endif
+
+    clip = _JMEST7735R_visibleRect(display, clip);
+    for (uint16_t i = 0; i < length; i ++) {
+        JMEST7735RFontGlyph_t glyph;
+        if (_JMEST7735R_fontGlyph(font, string[i], &glyph)) {
+            width += glyph.advance * scale;
+        }
+    }
+    x0 = JMEMax(x, clip.origin.x);
+    x1 = JMEMin(x + width, clip.origin.x + clip.size.width);
+    y0 = JMEMax(y, clip.origin.y);
+    y1 = JMEMin(y + height, clip.origin.y + clip.size.height);
+    if (x0 >= x1 || y0 >= y1 || !_JMEST7735R_beginPixels(display, JMERectMake(x0, y0, x1 - x0, y1 - y0))) {
+        return;
+    }
+#if JMEST7735R_USE_GLYPHCACHE
+    //
+    // built-in font glyphs come from the cache; slots are looked up once and
+    // checked again afterwards, a later lookup may have reused one
+    for (uint8_t i = 0; i < JMEST7735R_RUN_CACHED_GLYPHS; i ++) {
+        JMEST7735RFontGlyph_t glyph;
+        cached[i] = NULL;
+        if (NULL == font && i < length && _JMEST7735R_fontGlyph(font, string[i], &glyph)) {
+            cached[i] = _JMEST7735R_cachedGlyph(display, table, JMEST7735R_FONT_ASCII8x12, string[i] - 32,
+                                                atlas + glyph.offset, JMEST7735R_ASCIISIZE, scale);
+        }
+    }
+    for (uint8_t i = 0; i < JMEST7735R_RUN_CACHED_GLYPHS; i ++) {
+        if (NULL != cached[i] && cached[i]->code != (uint8_t)(string[i] - 32)) {
+            cached[i] = NULL;
+        }
+    }
+#endif
+    block.fill = 0;
+    for (int16_t line = y0; line < y1; line ++) {
+        uint8_t row = (line - y) / scale;
+        int16_t cell = x;
+        for (uint16_t i = 0; i < length && cell < x1; i ++) {
+            JMEST7735RFontGlyph_t glyph;
+            int16_t advance;
+            if (!_JMEST7735R_fontGlyph(font, string[i], &glyph)) {
+                continue;
+            }
+            advance = glyph.advance * scale;
+            if (cell + advance > x0) {
+                uint16_t from = JMEMax(x0 - cell, 0);
+                uint16_t to = JMEMin(x1 - cell, advance);
+#if JMEST7735R_USE_GLYPHCACHE
+                if (i < JMEST7735R_RUN_CACHED_GLYPHS && NULL != cached[i]) {
+                    _JMEST7735R_blockBytes(display, &block, cached[i]->pixels + ((line - y) * advance + from) * 2, to - from);
+                    cell += advance;
+                    continue;
+                }
+#endif
+                _JMEST7735R_blockGlyphRow(display, &block, table, atlas, &glyph, row, from, to, scale);
+            }
+            cell += advance;
+        }
+    }
+    _JMEST7735R_flushBlock(display, &block);
+    _JMEST7735R_endPixels(display);
+}
+
+/**
+ *  Format `value' / 10^decimals into `text' and return its length: a minus
+ *  sign, at least one digit before the decimal point and exactly `decimals'
+ *  after it. A value wider than the field becomes a row of dashes.
+ */
+static uint8_t _JMEST7735R_formatNumber(const JMEST7735RNumber_t * number, int32_t value, char * text)
+{
+    char reversed[JMEST7735R_NUMBER_MAX_CHARS + 1];
+    uint32_t magnitude = (value < 0) ? 0 - (uint32_t)value : (uint32_t)value;
+    uint8_t width = JMEMin(number->width, JMEST7735R_NUMBER_MAX_CHARS);
+    uint8_t length = 0;
+    uint8_t digits = 0;
+    //
+    // last digit first; text that outgrows the buffer ends up wider than
+    // any field
+    do {
+        reversed[length ++] = '0' + magnitude % 10;
+        magnitude /= 10;
+        if (++ digits == number->decimals && length < sizeof(reversed)) {
+            reversed[length ++] = '.';
+        }
+    } while ((magnitude > 0 || digits <= number->decimals) && length < sizeof(reversed));
+    if (value < 0 && length < sizeof(reversed)) {
+        reversed[length ++] = '-';
+    }
+    //
+    // the field width counts the sign and the point as well
+    if (length > width) {
+        memset(text, '-', width);
+        length = width;
+    } else {
+        for (uint8_t i = 0; i < length; i ++) {
+            text[i] = reversed[length - 1 - i];
+        }
+    }
+    text[length] = '\0';
+    return length;
+}
+
+/**
+ *  Screen area of a number readout, `width' times the advance of its '0'
+ *  wide, and the left edge of `text' aligned in it.
+ */
+static JMERect _JMEST7735R_numberField(const JMEST7735RNumber_t * number, const char * text, int16_t * textX)
+{
+    JMEST7735RFontGlyph_t glyph;
+    uint8_t scale = number->fontSize;
+    uint16_t digitWidth = _JMEST7735R_fontGlyph(number->font, '0', &glyph) ? glyph.advance * scale : 0;
+    uint8_t lineHeight = (NULL != number->font) ? number->font->lineHeight : JMEST7735R_ASCIISIZE.height;
+    JMERect field = JMERectMake(number->origin.x, number->origin.y, number->width * digitWidth, lineHeight * scale);
+    int16_t space = (int16_t)field.size.width - (int16_t)(JMEST7735RFont_measure(number->font, text) * scale);
+
+    *textX = field.origin.x;
+    if (JMEST7735R_ALIGN_RIGHT == number->alignment) {
+        *textX += space;
+    } else if (JMEST7735R_ALIGN_CENTER == number->alignment) {
+        *textX += space / 2;
+    }
+    return field;
+}
+
+/**
+ *  Bring a number readout from the text it shows to `text'. A character is
+ *  kept when the same one is already on screen at the same place; runs of
+ *  the others are redrawn with one window each and whatever the old text
+ *  covered outside the new one is cleared. `isRepaint' draws the whole field.
+ */
+static void _JMEST7735R_drawNumberField(JMEST7735RDisplay_t * display, JMEST7735RNumber_t * number, const char * text, BOOL isRepaint)
+{
+    JMEST7735R_MonoTable_t table;
+    uint8_t scale = number->fontSize;
+    int16_t x;
+    JMERect field = _JMEST7735R_numberField(number, text, &x);
+    int16_t fieldEnd = field.origin.x + field.size.width;
+    const char * old = number->shown;
+    int16_t oldX = number->shownX;
+    int16_t oldStart, oldEnd;
+    int16_t textEnd = x + JMEST7735RFont_measure(number->font, text) * scale;
+    int16_t run = -1, runX = 0;
+    uint8_t i = 0;
+
+    if (isRepaint || !number->isShown ||
+        number->textColor != number->shownTextColor || number->bgColor != number->shownBgColor) {
+        old = "";
+        oldStart = field.origin.x;
+        oldEnd = fieldEnd;
+    } else {
+        oldStart = oldX;
+        oldEnd = oldX + JMEST7735RFont_measure(number->font, old) * scale;
+    }
+    oldX = oldStart;
+    _JMEST7735R_buildMonoTable(&table, number->textColor, number->bgColor);
+    for (int16_t cell = x; ; i ++) {
+        JMEST7735RFontGlyph_t glyph;
+        BOOL isKept = FALSE;
+        glyph.advance = 0;
+        if ('\0' != text[i]) {
+            if (!_JMEST7735R_fontGlyph(number->font, text[i], &glyph)) {
+                continue;
+            }
+            //
+            // the old character at this position, if one starts here
+            while ('\0' != *old && oldX < cell) {
+                JMEST7735RFontGlyph_t oldGlyph;
+                oldX += _JMEST7735R_fontGlyph(number->font, *old, &oldGlyph) ? oldGlyph.advance * scale : 0;
+                old ++;
+            }
+            isKept = (oldX == cell && *old == text[i]);
+        }
+        if (run >= 0 && ('\0' == text[i] || isKept)) {
+            _JMEST7735R_drawTextRun(display, &table, number->font, text + run, i - run, runX, field.origin.y, field, scale);
+            run = -1;
+        }
+        if ('\0' == text[i]) {
+            break;
+        }
+        if (!isKept && run < 0) {
+            run = i;
+            runX = cell;
+        }
+        cell += glyph.advance * scale;
+    }
+    //
+    // what is left of the old text on either side
+    oldStart = JMEMax(oldStart, field.origin.x);
+    oldEnd = JMEMin(oldEnd, fieldEnd);
+    if (JMEMin(oldEnd, x) > oldStart) {
+        _JMEST7735R_fillSpan(display, oldStart, field.origin.y, JMEMin(oldEnd, x) - oldStart, field.size.height, number->bgColor);
+    }
+    if (oldEnd > JMEMax(oldStart, textEnd)) {
+        int16_t start = JMEMax(oldStart, textEnd);
+        _JMEST7735R_fillSpan(display, start, field.origin.y, oldEnd - start, field.size.height, number->bgColor);
+    }
+
+    if (text != number->shown) {
+        memcpy(number->shown, text, strlen(text) + 1);
+    }
+    number->shownX = x;
+    number->shownTextColor = number->textColor;
+    number->shownBgColor = number->bgColor;
+    number->isShown = TRUE;
+}
+
+#if JMEST7735R_USE_GLYPHCACHE
+/**
+ *  Append `count' pixels already in wire order.
+ */
+static void _JMEST7735R_blockBytes(JMEST7735RDisplay_t * display, JMEST7735R_PixelBlock_t * block, const uint8_t * bytes, uint16_t count)
+{
+    while (count > 0) {
+        uint8_t pixels = JMEMin(count, (sizeof(block->bytes) - block->fill) >> 1);
+        if (0 == pixels) {
+            _JMEST7735R_flushBlock(display, block);
+            continue;
+        }
+        memcpy(block->bytes + block->fill, bytes, pixels * 2);
+        block->fill += pixels * 2;
+        bytes += pixels * 2;
+        count -= pixels;
+    }
+}
+
+/**
+ *  Expand a 1-bpp glyph, one byte per row, into `out' at `scale'.
+ */
+static void _JMEST7735R_expandMono(const JMEST7735R_MonoTable_t * table, const uint8_t * image,
+                                   uint8_t width, uint8_t height, uint8_t scale, uint8_t * out)
+{
+    uint16_t rowBytes = width * scale * 2;
+    for (uint8_t row = 0; row < height; row ++) {
+        uint8_t data = image[row];
+        if (1 == scale) {
+            _JMEST7735R_expandByte(table, data, width, out);
+        } else {
+            uint8_t * pixel = out;
+            for (uint8_t bit = 0; bit < width; bit ++, data <<= 1) {
+                const uint8_t * color = table->nibble[(data & 0x80) ? 0x0F : 0x00];
+                for (uint8_t i = 0; i < scale; i ++) {
+                    *pixel ++ = color[0];
+                    *pixel ++ = color[1];
+                }
+            }
+            //
+            // the other rows of the scaled source row are copies
+            for (uint8_t i = 1; i < scale; i ++) {
+                memcpy(out + i * rowBytes, out, rowBytes);
+            }
+        }
+        out += rowBytes * scale;
+    }
+}
+
+/**
+ *  Find a glyph in the cache, expanding it into the least recently used slot
+ *  on a miss. NULL when there is no cache or the glyph is too large for it.
+ */
+static JMEST7735R_Glyph_t * _JMEST7735R_cachedGlyph(JMEST7735RDisplay_t * display, const JMEST7735R_MonoTable_t * table,
+                                                    uint8_t font, uint8_t code, const uint8_t * image, JMESize size, uint8_t fontSize)
+{
+    JMEST7735R_Glyph_t * victim;
+    if (NULL == display->glyphs ||
+        size.width * size.height * fontSize * fontSize > JMEST7735R_GLYPH_SLOT_PIXELS) {
+        return NULL;
+    }
+    if (0 == ++ display->glyphClock) {
+        //
+        // clock wrapped: restart the recency order
+        for (uint8_t i = 0; i < display->glyphCount; i ++) {
+            display->glyphs[i].lastUse = 0;
+        }
+        display->glyphClock = 1;
+    }
+    victim = &display->glyphs[0];
+    for (uint8_t i = 0; i < display->glyphCount; i ++) {
+        JMEST7735R_Glyph_t * glyph = &display->glyphs[i];
+        if (glyph->font == font && glyph->code == code && glyph->fontSize == fontSize &&
+            glyph->fgColor == table->fgColor && glyph->bgColor == table->bgColor) {
+            glyph->lastUse = display->glyphClock;
+            return glyph;
+        }
+        if (glyph->lastUse < victim->lastUse) {
+            victim = glyph;
+        }
+    }
+    _JMEST7735R_expandMono(table, image, size.width, size.height, fontSize, victim->pixels);
+    victim->font = font;
+    victim->code = code;
+    victim->fontSize = fontSize;
+    victim->fgColor = table->fgColor;
+    victim->bgColor = table->bgColor;
+    victim->lastUse = display->glyphClock;
+    return victim;
+}
+#endif
+
+#if JMEST7735R_USE_RAMTARGET
+static inline void _JMEST7735R_storePixel(JMEST7735RDisplay_t * display, uint16_t color)
+{
+    uint16_t x = display->streamX - display->targetRect.origin.x;
+    uint16_t y = display->streamY - display->targetRect.origin.y;
+    if (x < display->targetRect.size.width && y < display->targetRect.size.height) {
+        display->target[y * display->targetRect.size.width + x] = color;
+    }
+    if (++ display->streamX >= display->streamRect.origin.x + display->streamRect.size.width) {
+        display->streamX = display->streamRect.origin.x;
+        display->streamY ++;
+    }
+}
+#endif
+
+#if JMEST7735R_USE_FRAMEBUFFER
+
+/**
+ *  Grow the damaged region by the on-screen part of `rect'.
+ */
+static void _JMEST7735R_invalidate(JMEST7735RDisplay_t * display, JMERect rect)
+{
+    rect = JMERectIntersection(rect, display->bounds);
+    if (JMERectIsEmpty(rect)) {
+        return;
+    }
+    JMEDamageRegionAdd(&display->damage, rect);
+}
+
+/**
+ *  Send the framebuffer content of `rect' to the panel in one window.
+ */
+static void _JMEST7735R_flushFramebuffer(JMEST7735RDisplay_t * display, JMERect rect)
+{
+    rect = _JMEST7735R_scannedRect(display, rect);
+    if (_JMEST7735R_beginMemoryWrite(display, rect)) {
+        uint8_t stride = display->bounds.size.width;
+        const uint16_t * line = display->framebuffer + rect.origin.y * stride + rect.origin.x;
+        for (uint8_t row = 0; row < rect.size.height; row ++) {
+            _JMEST7735R_writePixelData(display, line, rect.size.width);
+            line += stride;
+        }
+        _JMEST7735R_endMemoryWrite(display);
+    }
+}
+
+static void _JMEST7735R_reversePixels(uint16_t * pixels, uint16_t count)
+{
+    for (uint16_t i = 0, j = count; i + 1 < j; i ++) {
+        uint16_t pixel = pixels[i];
+        pixels[i] = pixels[-- j];
+        pixels[j] = pixel;
+    }
+}
+#endif
+
+#if JMEST7735R_USE_BANDRENDER
+/**
+ *  Queue a draw call of the current frame, together with the screen area it
+ *  touches so that bands it misses can skip it.
+ */
+static BOOL _JMEST7735R_recordOp(JMEST7735RDisplay_t * display, const JMEST7735R_DrawOp_t * op)
+{
+    JMEST7735R_DrawOp_t * record;
+    uint16_t width = 0, height = 0;
+    if (display->opCount >= JMEST7735R_BAND_MAX_OPS) {
+        display->isOverflowed = TRUE;
+        return FALSE;
+    }
+    record = &display->ops[display->opCount ++];
+    *record = *op;
+    switch (op->type) {
+        case JMEST7735R_OP_LINE:
+            record->bounds.origin.x = JMEMax(JMEMin(op->frame.origin.x, op->point.x) - op->param / 2, 0);
+            record->bounds.origin.y = JMEMax(JMEMin(op->frame.origin.y, op->point.y) - op->param / 2, 0);
+            width = JMEMax(op->frame.origin.x, op->point.x) - record->bounds.origin.x + op->param;
+            height = JMEMax(op->frame.origin.y, op->point.y) - record->bounds.origin.y + op->param;
+            break;
+        case JMEST7735R_OP_NUMBER:
+            record->bounds.origin = op->frame.origin;
+            width = 3 * JMEST7735R_NUMBERSIZE.width * op->param;
+            height = JMEST7735R_NUMBERSIZE.height * op->param;
+            break;
+        case JMEST7735R_OP_STRING:
+            record->bounds.origin = op->frame.origin;
+            width = strlen((const char *)op->data) * JMEST7735R_ASCIISIZE.width * op->param;
+            height = JMEST7735R_ASCIISIZE.height * op->param;
+            break;
+        case JMEST7735R_OP_TEXT:
+            record->bounds.origin = op->frame.origin;
+            if (op->param) {
+                width = op->frame.size.width;
+                height = op->frame.size.height;
+                break;
+            }
+            width = JMEST7735RFont_measure(op->font, (const char *)op->data);
+            height = NULL != op->font ? op->font->lineHeight : JMEST7735R_ASCIISIZE.height;
+            break;
+        default:
+            record->bounds.origin = op->frame.origin;
+            width = op->frame.size.width;
+            height = op->frame.size.height;
+            break;
+    }
+    //
+    // clamp to the screen so the geometry stays inside JMEGeometryUnit
+    record->bounds.size.width = record->bounds.origin.x < display->bounds.size.width ?
+    JMEMin(width, display->bounds.size.width - record->bounds.origin.x) : 0;
+    record->bounds.size.height = record->bounds.origin.y < display->bounds.size.height ?
+    JMEMin(height, display->bounds.size.height - record->bounds.origin.y) : 0;
+    //
+    // a call entirely outside the clip is not queued
+    record->clip = display->clip;
+    record->bounds = JMERectIntersection(record->bounds, display->clip);
+    if (JMERectIsEmpty(record->bounds)) {
+        display->opCount --;
+    }
+    return TRUE;
+}
+
+static void _JMEST7735R_replayOp(JMEST7735RDisplay_t * display, const JMEST7735R_DrawOp_t * op)
+{
+    JMEMenuIcon_t icon;
+    switch (op->type) {
+        case JMEST7735R_OP_LINE:
+            JMEST7735RDisplay_drawThickLine(display, op->frame.origin, op->point, op->param, op->color);
+            break;
+        case JMEST7735R_OP_RECT:
+            JMEST7735RDisplay_drawRect(display, op->frame, op->color, op->param);
+            break;
+        case JMEST7735R_OP_BITMAP:
+            JMEST7735RDisplay_drawBitmap(display, (const uint16_t *)op->data, op->frame, op->param);
+            break;
+        case JMEST7735R_OP_RLEBITMAP:
+            JMEST7735RDisplay_drawCompressedBitmap(display, (const uint8_t *)op->data, op->frame);
+            break;
+        case JMEST7735R_OP_INDEXEDBITMAP:
+            JMEST7735RDisplay_drawIndexedBitmap(display, (const uint8_t *)op->data, op->frame, op->param, op->palette);
+            break;
+        case JMEST7735R_OP_BINARYIMAGE:
+            JMEST7735RDisplay_drawBinaryImageStride(display, (const uint8_t *)op->data, op->frame, op->number, op->color, op->bgColor);
+            break;
+        case JMEST7735R_OP_NUMBER:
+            JMEST7735RDisplay_drawNumber(display, op->frame.origin, op->number, op->color, op->bgColor, op->param);
+            break;
+        case JMEST7735R_OP_STRING:
+            JMEST7735RDisplay_drawString(display, op->frame.origin, (const char *)op->data, op->color, op->bgColor, op->param);
+            break;
+        case JMEST7735R_OP_TEXT:
+            if (op->param) {
+                JMEST7735RDisplay_drawTextInRect(display, op->frame, (const char *)op->data, op->font, op->color, op->bgColor);
+            } else {
+                JMEST7735RDisplay_drawText(display, op->frame.origin, (const char *)op->data, op->font, op->color, op->bgColor);
+            }
+            break;
+        case JMEST7735R_OP_READOUT:
+            _JMEST7735R_drawNumberField(display, (JMEST7735RNumber_t *)op->data, ((const JMEST7735RNumber_t *)op->data)->shown, TRUE);
+            break;
+        case JMEST7735R_OP_BINARYICON:
+        case JMEST7735R_OP_MENUICON:
+            icon.iconFrame = op->frame;
+            icon.iconSize = op->size;
+            icon.iconData = (const uint8_t *)op->data;
+            icon.color = op->color;
+            icon.bgColor = op->bgColor;
+            if (JMEST7735R_OP_BINARYICON == op->type) {
+                JMEST7735RDisplay_drawBinaryIcon(display, &icon);
+            } else {
+                JMEST7735RDisplay_drawMenuIcon(display, &icon, op->param);
+            }
+            break;
+        default:
+            break;
+    }
+}
+#endif
+
+/**
+ *  Fill the part of `(x, y; width, height)' inside the clip with one window.
+ *  Nothing reaches the bus when the span is entirely clipped.
+ */
+static void _JMEST7735R_fillSpan(JMEST7735RDisplay_t * display, int16_t x, int16_t y, int16_t width, int16_t height, uint16_t color)
+{
+    JMERect clip = _JMEST7735R_visibleRect(display, display->clip);
+    int16_t x1 = JMEMin(x + width, clip.origin.x + clip.size.width);
+    int16_t y1 = JMEMin(y + height, clip.origin.y + clip.size.height);
+    x = JMEMax(x, clip.origin.x);
+    y = JMEMax(y, clip.origin.y);
+    width = x1 - x;
+    height = y1 - y;
+    if (width > 0 && height > 0) {
+        if (_JMEST7735R_beginPixels(display, JMERectMake(x, y, width, height))) {
+            _JMEST7735R_pushColor(display, color, width * height);
+            _JMEST7735R_endPixels(display);
+        }
+    }
+}
+
+/**
+ *  Integer Bresenham from `start' towards `end', end point excluded. Pixels
+ *  that share a row (x-major) or a column (y-major) are sent as one span,
+ *  widened to `thickness' across the major axis.
+ */
+static void _JMEST7735R_rasterLine(JMEST7735RDisplay_t * display, JMEPoint start, JMEPoint end, uint8_t thickness, uint16_t color)
+{
+    int16_t dx = (int16_t)end.x - start.x;
+    int16_t dy = (int16_t)end.y - start.y;
+    int16_t sx = dx < 0 ? -1 : 1;
+    int16_t sy = dy < 0 ? -1 : 1;
+    int16_t offset = (thickness - 1) >> 1;
+    int16_t x = start.x;
+    int16_t y = start.y;
+    int16_t runStart, runLength = 0;
+    int16_t error;
+
+    dx = JMEABS(dx);
+    dy = JMEABS(dy);
+    if (dx >= dy) {
+        error = 2 * dy - dx;
+        runStart = x;
+        for (int16_t i = 0; i < dx; i ++) {
+            runLength ++;
+            if (error > 0) {
+                _JMEST7735R_fillSpan(display, sx > 0 ? runStart : x, y - offset, runLength, thickness, color);
+                y += sy;
+                error -= 2 * dx;
+                runLength = 0;
+                runStart = x + sx;
+            }
+            error += 2 * dy;
+            x += sx;
+        }
+        if (runLength > 0) {
+            _JMEST7735R_fillSpan(display, sx > 0 ? runStart : x - sx, y - offset, runLength, thickness, color);
+        }
+    } else {
+        error = 2 * dx - dy;
+        runStart = y;
+        for (int16_t i = 0; i < dy; i ++) {
+            runLength ++;
+            if (error > 0) {
+                _JMEST7735R_fillSpan(display, x - offset, sy > 0 ? runStart : y, thickness, runLength, color);
+                x += sx;
+                error -= 2 * dy;
+                runLength = 0;
+                runStart = y + sy;
+            }
+            error += 2 * dx;
+            y += sy;
+        }
+        if (runLength > 0) {
+            _JMEST7735R_fillSpan(display, x - offset, sy > 0 ? runStart : y - sy, thickness, runLength, color);
+        }
+    }
+}
+
+/**
+ *  Bus transactions. Chip select stays asserted from begin to end, so a
+ *  command and its parameters, or a whole sequence of commands, cost a single
+ *  CS cycle. _JMEST7735R_write_command and _JMEST7735R_write_data must only be
+ *  used inside a transaction.
+ */
+static inline void _JMEST7735R_beginTransaction(JMEST7735RDisplay_t * display) {
+#if JMEST7735R_USE_ASYNC
+    //
+    // the bus belongs to the pixel pipeline until its last block is out
+    _JMEST7735R_waitTransfer(display);
+#endif
+    display->adapter->select(display->adapter->context, TRUE);
+}
+
+static inline void _JMEST7735R_endTransaction(JMEST7735RDisplay_t * display) {
+    display->adapter->select(display->adapter->context, FALSE);
+}
+
+static inline void _JMEST7735R_write_command(JMEST7735RDisplay_t * display, uint8_t cmd) {
+    display->adapter->writeCommand(display->adapter->context, cmd);
+}
+
+static inline void _JMEST7735R_write_data(JMEST7735RDisplay_t * display, uint8_t data) {
+    display->adapter->writeBlock(display->adapter->context, &data, 1);
+}
+
+static inline void _JMEST7735R_write_params(JMEST7735RDisplay_t * display, const uint8_t * params, uint8_t count) {
+    if (count > 0) {
+        display->adapter->writeBlock(display->adapter->context, params, count);
+    }
+}
+
+static void _JMEST7735R_writeCommandGroup(JMEST7735RDisplay_t * display, uint8_t cmd, const uint8_t * params, uint8_t count) {
+    _JMEST7735R_beginTransaction(display);
+    _JMEST7735R_write_command(display, cmd);
+    _JMEST7735R_write_params(display, params, count);
+    _JMEST7735R_endTransaction(display);
+}
+
+static inline void _JMEST7735R_delay(JMEST7735RDisplay_t * display, uint16_t ms) {
+    if (NULL != display->adapter->delayMS) {
+        display->adapter->delayMS(display->adapter->context, ms);
+        return;
+    }
+    JMEST7735R_delayMS(ms);
+}
+
+static inline uint8_t _JMEST7735R_read_data(JMEST7735RDisplay_t * display) {
+    uint8_t data = 0;
+    display->adapter->readBlock(display->adapter->context, &data, 1);
     return data;
 }
@@ -28,39 +28,368 @@ typedef struct {
     uint16_t            bgColor;
 }JMEMenuIcon_t;
 
+/**
+ *  One glyph of a proportional font: a 1-bpp bitmap of its inked box only,
+ *  leftmost pixel in bit 7 and rows padded to whole bytes, inside a cell of
+ *  `advance' x the font's line height.
+ */
+typedef struct {
+    uint16_t            offset;             ///< first bitmap byte in the atlas
+    uint8_t             width;              ///< inked box size, 0 for a blank glyph
+    uint8_t             height;
+    uint8_t             left;               ///< inked box origin inside the cell
+    uint8_t             top;
+    uint8_t             advance;            ///< cell width, pen movement to the next glyph
+}JMEST7735RFontGlyph_t;
+
+/**
+ *  Proportional font: the bitmaps of all glyphs packed back to back in
+ *  `atlas', one JMEST7735RFontGlyph_t per character code from `firstCode'.
+ *  Codes outside the font are skipped. A NULL font is the built-in 8x12
+ *  ASCII font of JMEST7735R_drawString.
+ */
+typedef struct {
+    const uint8_t       * atlas;
+    const JMEST7735RFontGlyph_t * glyphs;
+    uint8_t             firstCode;
+    uint8_t             glyphCount;
+    uint8_t             lineHeight;
+}JMEST7735RFont_t;
+
+typedef enum {
+    JMEST7735R_ALIGN_LEFT,
+    JMEST7735R_ALIGN_RIGHT,
+    JMEST7735R_ALIGN_CENTER
+}JMEST7735R_ALIGN;
+
+/**
+ *  Screen orientation, clockwise from the panel's native portrait mounting.
+ */
+typedef enum {
+    JMEST7735R_ROTATION_0,
+    JMEST7735R_ROTATION_90,
+    JMEST7735R_ROTATION_180,
+    JMEST7735R_ROTATION_270
+}JMEST7735R_ROTATION;
+
+/**
+ *  Interface pixel format on the bus. Colors are RGB565 in every call; 12-bit
+ *  sends two pixels in 3 bytes, 18-bit one pixel in 3 bytes.
+ */
+typedef enum {
+    JMEST7735R_IPF_12        = 0x03,
+    JMEST7735R_IPF_16        = 0x05,
+    JMEST7735R_IPF_18        = 0x06,
+    JMEST7735R_IPF_NOUSED    = 0x07
+}JMEST7735R_IPF;
+
+#define JMEST7735R_NUMBER_MAX_CHARS     12      ///< sign, ten digits and the decimal point
+
+/**
+ *  Number readout: a signed fixed-point value in a field `width' characters
+ *  wide, drawn with `font' at `fontSize'. The '-' and the decimal point count
+ *  as characters; the field is `width' times the advance of '0' wide. The
+ *  readout remembers the text on screen and an update redraws only the
+ *  characters that changed. Fill in the settings and call
+ *  JMEST7735RNumber_invalidate (or zero the struct) before the first update;
+ *  values wider than the field show as dashes.
+ */
+typedef struct {
+    JMEPoint            origin;             ///< top-left corner of the field
+    const JMEST7735RFont_t * font;          ///< NULL for the built-in 8x12 font
+    uint16_t            textColor;
+    uint16_t            bgColor;
+    uint8_t             fontSize;
+    uint8_t             width;              ///< field width in characters, sign and point included, at most JMEST7735R_NUMBER_MAX_CHARS
+    uint8_t             decimals;           ///< digits after the decimal point
+    uint8_t             alignment;          ///< JMEST7735R_ALIGN
+    //
+    // what the panel shows, kept by the driver
+    BOOL                isShown;
+    int16_t             shownX;             ///< left edge of the shown text
+    uint16_t            shownTextColor;
+    uint16_t            shownBgColor;
+    char                shown[JMEST7735R_NUMBER_MAX_CHARS + 1];
+}JMEST7735RNumber_t;
+
+/**
+ *  One panel: adapter, geometry, cached address window and pixel format.
+ *  Obtained from JMEST7735RDisplay_create or JMEST7735RDisplay_default.
+ */
+typedef struct JMEST7735RDisplay JMEST7735RDisplay_t;
+
+/**
+ *  Bus adapter. The driver reaches the panel only through these entry points,
+ *  so 8080 parallel, 4-wire SPI or 9-bit 3-wire SPI transports plug in without
+ *  touching it. `context' is passed back to every entry.
+ */
+typedef struct {
+    void                * context;
+    void                (* select)(void * context, BOOL isSelected);    ///< chip select around a transaction
+    void                (* writeCommand)(void * context, uint8_t cmd);
+    void                (* writeBlock)(void * context, const uint8_t * data, uint16_t length);
+    void                (* fillRepeat)(void * context, uint16_t color, uint16_t count); ///< `count' RGB565 pixels, high byte first
+    void                (* readBlock)(void * context, uint8_t * data, uint16_t length);
+    void                (* setReset)(void * context, BOOL isActive);    ///< optional, NULL resets by command
+    void                (* setBacklight)(void * context, BOOL isOn);    ///< optional
+    //
+    // optional, JMEST7735R_USE_ASYNC only: start writing `length' data bytes
+    // and call JMEST7735RDisplay_blockWriteDone(display) when they are out;
+    // NULL writes the block with writeBlock
+    void                (* startBlock)(void * context, JMEST7735RDisplay_t * display, const uint8_t * data, uint16_t length);
+    void                (* waitBlock)(void * context);                  ///< block until a started block may have completed
+    void                (* delayMS)(void * context, uint16_t ms);       ///< optional, NULL waits with JMEST7735R_delayMS
+}JMEST7735RAdapter_t;
+
+typedef uint32_t JMEST7735RFence_t;     ///< sequence number of a queued pixel block
+//
+// called from the transfer completion interrupt (worker thread on the host)
+// with the fence of the block that finished; must not draw
+typedef void (* JMEST7735RCompletion_t)(JMEST7735RFence_t fence, void * context);
+
 /*********************************************************************
  * MACROS
  */
 #define JMEST7735RSCREENWIDTH           128
 #define JMEST7735RSCREENHEIGHT          160
+#ifndef JMEST7735R_GRAM_LINES
+#define JMEST7735R_GRAM_LINES           JMEST7735RSCREENHEIGHT  ///< frame memory lines the panel scans, 162 on 132x162 modules
+#endif
+#ifndef JMEST7735R_GRAM_COLUMNS
+#define JMEST7735R_GRAM_COLUMNS         JMEST7735RSCREENWIDTH   ///< frame memory columns, 132 on 132x162 modules
+#endif
+
+//
+// off-screen framebuffer mode: draw calls render into a caller supplied
+// RGB565 buffer and JMEST7735R_refreshScreen sends the damaged region
+#ifndef JMEST7735R_USE_FRAMEBUFFER
+#define JMEST7735R_USE_FRAMEBUFFER      0
+#endif
+#define JMEST7735R_FRAMEBUFFER_PIXELS   (JMEST7735RSCREENWIDTH * JMEST7735RSCREENHEIGHT)
+//
+// band rendering: draw calls between JMEST7735R_beginFrame and
+// JMEST7735R_endFrame are queued and replayed per horizontal strip
+#ifndef JMEST7735R_USE_BANDRENDER
+#define JMEST7735R_USE_BANDRENDER       0
+#endif
+#ifndef JMEST7735R_BAND_HEIGHT
+#define JMEST7735R_BAND_HEIGHT          4       ///< strip buffer is JMEST7735RSCREENHEIGHT x this, RGB565
+#endif
+#ifndef JMEST7735R_BAND_MAX_OPS
+#define JMEST7735R_BAND_MAX_OPS         24      ///< draw calls queued per frame
+#endif
+//
+// clip rectangles saved by JMEST7735R_pushClip
+#ifndef JMEST7735R_CLIP_DEPTH
+#define JMEST7735R_CLIP_DEPTH           4
+#endif
+//
+// display contexts, including the one behind the JMEST7735R_* functions
+#ifndef JMEST7735R_MAX_DISPLAYS
+#define JMEST7735R_MAX_DISPLAYS         1
+#endif
+//
+// RLE RGB565 images: a sequence of packets, each a control byte followed by
+// pixel data in wire order (high byte first).
+//   1nnnnnnn c1 c0          run: n + 1 pixels of color c1c0
+//   0nnnnnnn [c1 c0] x n+1  literal: n + 1 pixels
+// Packets may cross rows; decoding stops after width * height pixels.
+#define JMEST7735R_RLE_RUN              0x80
+#define JMEST7735R_RLE_COUNT_MASK       0x7F
+#define JMEST7735R_RLE_MAX_COUNT        128     ///< pixels per packet
+//
+// indexed images: 2, 4 or 8 bits per pixel, leftmost pixel in the most
+// significant bits, every row starting on a byte boundary
+#define JMEST7735R_INDEXED_STRIDE(width, bitsPerPixel)  (((width) * (bitsPerPixel) + 7) >> 3)
+//
+// binary images: leftmost pixel in bit 7, every row starting on a byte
+// boundary; JMEST7735R_drawBinaryImage assumes the tightest stride
+#define JMEST7735R_BINARY_STRIDE(width) (((width) + 7) >> 3)
+#ifndef JMEST7735R_MONO_BLOCK_PIXELS
+#define JMEST7735R_MONO_BLOCK_PIXELS    32      ///< pixels per block of expanded 1-bpp data, a multiple of 8
+#endif
+//
+// glyph cache: drawString and drawNumber keep recently drawn glyphs, already
+// expanded to wire order for their font size and colors, in a caller supplied
+// arena and replace the least recently used one
+#ifndef JMEST7735R_USE_GLYPHCACHE
+#define JMEST7735R_USE_GLYPHCACHE       0
+#endif
+#ifndef JMEST7735R_GLYPH_SLOT_PIXELS
+#define JMEST7735R_GLYPH_SLOT_PIXELS    (8 * 12 * 4)    ///< largest cached glyph, 8x12 at font size 2
+#endif
+#define JMEST7735R_GLYPH_SLOT_BYTES     (10 + JMEST7735R_GLYPH_SLOT_PIXELS * 2)     ///< arena bytes per glyph
+#define JMEST7735R_USE_RAMTARGET        (JMEST7735R_USE_FRAMEBUFFER || JMEST7735R_USE_BANDRENDER)
+//
+// asynchronous transfer: pixel data is packed into one of two line buffers
+// while the adapter drains the other, draw calls return once their last block
+// is queued
+#ifndef JMEST7735R_USE_ASYNC
+#define JMEST7735R_USE_ASYNC            0
+#endif
+#ifndef JMEST7735R_ASYNC_LINE_BYTES
+#define JMEST7735R_ASYNC_LINE_BYTES     (JMEST7735RSCREENWIDTH * 2)     ///< bytes per line buffer, even
+#endif
 
 /*********************************************************************
  * EXTERN VARIABLES
  */
 JME_EXTERN const JMERect kJMEST7735RScreenFrame;
+JME_EXTERN const JMEST7735RAdapter_t kJMEST7735RDefaultAdapter;    ///< built from the OBST7735R_Adapter.h macros
 
 /*********************************************************************
  * FUNCTIONS
  */
 //
-// JMEST7735R control function
+// display context; every JMEST7735R_* function below drives
+// JMEST7735RDisplay_default(). Create displays before sharing them between
+// threads; each display must only be used by one thread at a time.
+JME_EXTERN JMEST7735RDisplay_t * JMEST7735RDisplay_default(void);
+JME_EXTERN JMEST7735RDisplay_t * JMEST7735RDisplay_create(const JMEST7735RAdapter_t * adapter, JMERect frame);
+JME_EXTERN void JMEST7735RDisplay_setAdapter(JMEST7735RDisplay_t * display, const JMEST7735RAdapter_t * adapter);
+JME_EXTERN void JMEST7735RDisplay_init(JMEST7735RDisplay_t * display);
+JME_EXTERN void JMEST7735RDisplay_resume(JMEST7735RDisplay_t * display);
+JME_EXTERN void JMEST7735RDisplay_enterSleep(JMEST7735RDisplay_t * display);
+JME_EXTERN void JMEST7735RDisplay_exitSleep(JMEST7735RDisplay_t * display);
+JME_EXTERN void JMEST7735RDisplay_setRotation(JMEST7735RDisplay_t * display, JMEST7735R_ROTATION rotation, BOOL isMirrored);
+JME_EXTERN JMERect JMEST7735RDisplay_getBounds(JMEST7735RDisplay_t * display);
+JME_EXTERN void JMEST7735RDisplay_setPixelFormat(JMEST7735RDisplay_t * display, JMEST7735R_IPF pixelFormat);
+JME_EXTERN BOOL JMEST7735RDisplay_pushClip(JMEST7735RDisplay_t * display, JMERect rect);
+JME_EXTERN void JMEST7735RDisplay_popClip(JMEST7735RDisplay_t * display);
+JME_EXTERN void JMEST7735RDisplay_enterPartialMode(JMEST7735RDisplay_t * display, uint8_t top, uint8_t height);
+JME_EXTERN void JMEST7735RDisplay_exitPartialMode(JMEST7735RDisplay_t * display);
+JME_EXTERN void JMEST7735RDisplay_enterIdleMode(JMEST7735RDisplay_t * display);
+JME_EXTERN void JMEST7735RDisplay_exitIdleMode(JMEST7735RDisplay_t * display);
+JME_EXTERN void JMEST7735RDisplay_setScrollArea(JMEST7735RDisplay_t * display, uint8_t topFixed, uint8_t bottomFixed);
+JME_EXTERN void JMEST7735RDisplay_setScrollOffset(JMEST7735RDisplay_t * display, uint8_t offset);
+JME_EXTERN uint8_t JMEST7735RDisplay_getScrollOffset(JMEST7735RDisplay_t * display);
+JME_EXTERN void JMEST7735RDisplay_scroll(JMEST7735RDisplay_t * display, int16_t lines);
+JME_EXTERN void JMEST7735RDisplay_setCompletionCallback(JMEST7735RDisplay_t * display, JMEST7735RCompletion_t callback, void * context);
+JME_EXTERN JMEST7735RFence_t JMEST7735RDisplay_fence(JMEST7735RDisplay_t * display);
+JME_EXTERN BOOL JMEST7735RDisplay_isFenceDone(JMEST7735RDisplay_t * display, JMEST7735RFence_t fence);
+JME_EXTERN void JMEST7735RDisplay_waitFence(JMEST7735RDisplay_t * display, JMEST7735RFence_t fence);
+JME_EXTERN void JMEST7735RDisplay_blockWriteDone(JMEST7735RDisplay_t * display);
+JME_EXTERN void JMEST7735RDisplay_setFramebuffer(JMEST7735RDisplay_t * display, uint16_t * framebuffer);
+JME_EXTERN void JMEST7735RDisplay_setGlyphCache(JMEST7735RDisplay_t * display, void * arena, uint16_t length);
+JME_EXTERN void JMEST7735RDisplay_refreshScreen(JMEST7735RDisplay_t * display);
+JME_EXTERN void JMEST7735RDisplay_beginFrame(JMEST7735RDisplay_t * display, uint16_t bgColor);
+JME_EXTERN BOOL JMEST7735RDisplay_endFrame(JMEST7735RDisplay_t * display);
+JME_EXTERN void JMEST7735RDisplay_fillScreen(JMEST7735RDisplay_t * display, uint16_t color);
+JME_EXTERN void JMEST7735RDisplay_drawLine(JMEST7735RDisplay_t * display, JMEPoint start, JMEPoint end, uint16_t color);
+JME_EXTERN void JMEST7735RDisplay_drawThickLine(JMEST7735RDisplay_t * display, JMEPoint start, JMEPoint end,
+                                                uint8_t thickness, uint16_t color);
+JME_EXTERN void JMEST7735RDisplay_drawRect(JMEST7735RDisplay_t * display, JMERect frame, uint16_t color, BOOL fill);
+JME_EXTERN void JMEST7735RDisplay_drawBitmap(JMEST7735RDisplay_t * display, const uint16_t * image, JMERect frame, BOOL isHighLight);
+JME_EXTERN void JMEST7735RDisplay_drawCompressedBitmap(JMEST7735RDisplay_t * display, const uint8_t * image, JMERect frame);
+JME_EXTERN void JMEST7735RDisplay_drawIndexedBitmap(JMEST7735RDisplay_t * display, const uint8_t * image, JMERect frame,
+                                                   uint8_t bitsPerPixel, const uint16_t * palette);
+JME_EXTERN void JMEST7735RDisplay_drawBinaryImage(JMEST7735RDisplay_t * display, const uint8_t * image, JMERect frame,
+                                                  uint16_t fgColor, uint16_t bgColor);
+JME_EXTERN void JMEST7735RDisplay_drawBinaryImageStride(JMEST7735RDisplay_t * display, const uint8_t * image, JMERect frame,
+                                                        uint16_t stride, uint16_t fgColor, uint16_t bgColor);
+JME_EXTERN void JMEST7735RDisplay_drawBinaryIcon(JMEST7735RDisplay_t * display, const JMEMenuIcon_t * icon);
+JME_EXTERN void JMEST7735RDisplay_drawNumber(JMEST7735RDisplay_t * display, JMEPoint startPoint, uint16_t number,
+                                             uint16_t textColor, uint16_t bgColor, uint8_t fontSize);
+JME_EXTERN void JMEST7735RDisplay_drawMenuIcon(JMEST7735RDisplay_t * display, const JMEMenuIcon_t * icon, BOOL isHighLight);
+JME_EXTERN void JMEST7735RDisplay_drawString(JMEST7735RDisplay_t * display, JMEPoint startPoint, const char * string,
+                                             uint16_t textColor, uint16_t bgColor, uint8_t fontSize);
+JME_EXTERN void JMEST7735RDisplay_drawText(JMEST7735RDisplay_t * display, JMEPoint startPoint, const char * string,
+                                           const JMEST7735RFont_t * font, uint16_t textColor, uint16_t bgColor);
+JME_EXTERN uint16_t JMEST7735RDisplay_drawTextInRect(JMEST7735RDisplay_t * display, JMERect rect, const char * string,
+                                                     const JMEST7735RFont_t * font, uint16_t textColor, uint16_t bgColor);
+JME_EXTERN void JMEST7735RDisplay_updateNumber(JMEST7735RDisplay_t * display, JMEST7735RNumber_t * number, int32_t value);
+//
+// JMEST7735R control function; resume restores the display mode and first
+// wakes the controller when JMEST7735R_enterSleep put it to sleep
+JME_EXTERN void JMEST7735R_setAdapter(const JMEST7735RAdapter_t * adapter);
 JME_EXTERN void JMEST7735R_init(void);
+JME_EXTERN void JMEST7735R_resume(void);
 JME_EXTERN void JMEST7735R_enterSleep(void);
 JME_EXTERN void JMEST7735R_exitSleep(void);
 //
+// orientation: the controller swaps and mirrors its address counters, so every
+// draw call works in the rotated coordinates at the same cost. The bounds
+// follow the rotation (160x128 at 90 and 270 degrees); the screen has to be
+// drawn again afterwards. Scrolling and partial mode need rotation 0.
+JME_EXTERN void JMEST7735R_setRotation(JMEST7735R_ROTATION rotation, BOOL isMirrored);
+JME_EXTERN JMERect JMEST7735R_getBounds(void);
+//
+// pixel format on the bus, RGB565 after init. 12-bit cuts pixel data by a
+// quarter at 4 bits per component; colors are narrowed on the way out.
+JME_EXTERN void JMEST7735R_setPixelFormat(JMEST7735R_IPF pixelFormat);
+//
+// clip stack: every draw call is cut to the intersection of the pushed
+// rectangles and the screen. Draw calls outside it send nothing; pushClip
+// fails when JMEST7735R_CLIP_DEPTH rectangles are already pushed.
+JME_EXTERN BOOL JMEST7735R_pushClip(JMERect rect);
+JME_EXTERN void JMEST7735R_popClip(void);
+//
+// partial mode: only rows `top' to `top + height' are scanned, draw calls that
+// miss them are skipped; leave it to show and draw the whole screen again.
+// Idle mode shows 8 colors, the most significant bit of each component.
+JME_EXTERN void JMEST7735R_enterPartialMode(uint8_t top, uint8_t height);
+JME_EXTERN void JMEST7735R_exitPartialMode(void);
+JME_EXTERN void JMEST7735R_enterIdleMode(void);
+JME_EXTERN void JMEST7735R_exitIdleMode(void);
+//
+// hardware vertical scrolling: rows between `topFixed' and `bottomFixed' form
+// the scroll area. Scrolling moves its content up by `lines' (down when
+// negative) without sending pixels; draw calls keep using screen coordinates
+// and land where they are seen.
+JME_EXTERN void JMEST7735R_setScrollArea(uint8_t topFixed, uint8_t bottomFixed);
+JME_EXTERN void JMEST7735R_setScrollOffset(uint8_t offset);
+JME_EXTERN uint8_t JMEST7735R_getScrollOffset(void);
+JME_EXTERN void JMEST7735R_scroll(int16_t lines);
+//
+// transfer completion; without JMEST7735R_USE_ASYNC every fence is done
+JME_EXTERN void JMEST7735R_setCompletionCallback(JMEST7735RCompletion_t callback, void * context);
+JME_EXTERN JMEST7735RFence_t JMEST7735R_fence(void);
+JME_EXTERN BOOL JMEST7735R_isFenceDone(JMEST7735RFence_t fence);
+JME_EXTERN void JMEST7735R_waitFence(JMEST7735RFence_t fence);
+JME_EXTERN void JMEST7735R_blockWriteDone(void);
+//
 // drawing function
+JME_EXTERN void JMEST7735R_setFramebuffer(uint16_t * framebuffer);
+JME_EXTERN void JMEST7735R_setGlyphCache(void * arena, uint16_t length);
 JME_EXTERN void JMEST7735R_refreshScreen(void);
+JME_EXTERN void JMEST7735R_beginFrame(uint16_t bgColor);
+JME_EXTERN BOOL JMEST7735R_endFrame(void);
 JME_EXTERN void JMEST7735R_fillScreen(uint16_t color);
 JME_EXTERN void JMEST7735R_drawLine(JMEPoint start, JMEPoint end, uint16_t color);
+JME_EXTERN void JMEST7735R_drawThickLine(JMEPoint start, JMEPoint end, uint8_t thickness, uint16_t color);
 JME_EXTERN void JMEST7735R_drawRect(JMERect frame, uint16_t color, BOOL fill);
 JME_EXTERN void JMEST7735R_drawBitmap(const uint16_t * image, JMERect frame, BOOL isHighLight);
+JME_EXTERN void JMEST7735R_drawCompressedBitmap(const uint8_t * image, JMERect frame);
+JME_EXTERN void JMEST7735R_drawIndexedBitmap(const uint8_t * image, JMERect frame,
+                                            uint8_t bitsPerPixel, const uint16_t * palette);
 JME_EXTERN void JMEST7735R_drawBinaryImage(const uint8_t * image, JMERect frame,
                                            uint16_t fgColor, uint16_t bgColor);
+JME_EXTERN void JMEST7735R_drawBinaryImageStride(const uint8_t * image, JMERect frame, uint16_t stride,
+                                                 uint16_t fgColor, uint16_t bgColor);
 JME_EXTERN void JMEST7735R_drawBinaryIcon(const JMEMenuIcon_t * icon);
+//
+// three 5x8 digits of `number' modulo 1000, see JMEST7735R_updateNumber for readouts
 JME_EXTERN void JMEST7735R_drawNumber(JMEPoint startPoint, uint16_t number,
                                       uint16_t textColor, uint16_t bgColor, uint8_t fontSize);
 JME_EXTERN void JMEST7735R_drawMenuIcon(const JMEMenuIcon_t * icon, BOOL isHighLight);
 JME_EXTERN void JMEST7735R_drawString(JMEPoint startPoint, const char * string,
                                       uint16_t textColor, uint16_t bgColor, uint8_t fontSize);
+JME_EXTERN void JMEST7735R_drawText(JMEPoint startPoint, const char * string,
+                                    const JMEST7735RFont_t * font, uint16_t textColor, uint16_t bgColor);
+//
+// text in `rect', wrapped at spaces and line feeds; whole lines only, returns
+// the number of characters drawn or skipped over
+JME_EXTERN uint16_t JMEST7735R_drawTextInRect(JMERect rect, const char * string,
+                                              const JMEST7735RFont_t * font, uint16_t textColor, uint16_t bgColor);
+//
+// show `value' / 10^decimals in a number readout, redrawing changed characters
+JME_EXTERN void JMEST7735R_updateNumber(JMEST7735RNumber_t * number, int32_t value);
+//
+// proportional text: width of `string' in pixels, line height is the font's
+JME_EXTERN uint16_t JMEST7735RFont_measure(const JMEST7735RFont_t * font, const char * string);
+//
+// repaint the whole readout on its next update, e.g. after the screen under it
+// was cleared or its settings changed
+JME_EXTERN void JMEST7735RNumber_invalidate(JMEST7735RNumber_t * number);
 
 #endif /* defined(__H__JMEST7735R_DriveLib__H__) */
@@ -0,0 +1,680 @@
+/**
+ Filename:       OBST7735R_Simulator.c
+ Revised:        $Date: 2015-06-18$
+ Revision:       $Revision: 01 $
+
+ Description:    This file contains a software model of the ST7735R controller
+                 for host builds. Define JMEST7735R_HOST_SIM and the adapter
+                 routes every bus access of the driver into this model.
+
+ Copyright 2015 ObornJung. All rights reserved.
+ */
+
+/*********************************************************************
+ * INCLUDES
+ */
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include "JMEBase.h"
+#include "OBST7735R_Simulator.h"
+
+/*********************************************************************
+ * MACROS
+ */
+//
+// commands decoded by the model
+#define JMEST7735RSIM_NOP        0x00
+#define JMEST7735RSIM_SWRESET    0x01
+#define JMEST7735RSIM_SLPIN      0x10
+#define JMEST7735RSIM_SLPOUT     0x11
+#define JMEST7735RSIM_PTLON      0x12
+#define JMEST7735RSIM_NORON      0x13
+#define JMEST7735RSIM_DISPOFF    0x28
+#define JMEST7735RSIM_DISPON     0x29
+#define JMEST7735RSIM_CASET      0x2A
+#define JMEST7735RSIM_RASET      0x2B
+#define JMEST7735RSIM_RAMWR      0x2C
+#define JMEST7735RSIM_PTLAR      0x30
+#define JMEST7735RSIM_VSCRDEF    0x33
+#define JMEST7735RSIM_VSCSAD     0x37
+#define JMEST7735RSIM_IDMOFF     0x38
+#define JMEST7735RSIM_IDMON      0x39
+#define JMEST7735RSIM_MADCTL     0x36
+#define JMEST7735RSIM_COLMOD     0x3A
+//
+// MADCTL bits
+#define JMEST7735RSIM_MY         0x80
+#define JMEST7735RSIM_MX         0x40
+#define JMEST7735RSIM_MV         0x20
+
+/*********************************************************************
+ * LOCAL VARIABLES
+ */
+//
+// the panel behind the bus line functions and OBST7735R_Adapter.h
+static JMEST7735RSimPanel_t _panel = {
+    {FALSE, FALSE, FALSE, FALSE, TRUE, FALSE, FALSE, FALSE,
+     0x00, 0x06, JMEST7735RSIM_NOP, 0, {0, 0, 0, 0, 0, 0},
+     0, JMEST7735RSIM_WIDTH - 1, 0, JMEST7735RSIM_HEIGHT - 1,
+     0, 0, {0, 0, 0}, 0,
+     0, JMEST7735RSIM_HEIGHT, 0, 0,
+     0, JMEST7735RSIM_HEIGHT - 1},
+    {0},
+    {PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER}
+};
+
+/*********************************************************************
+ * LOCAL FUNCTIONS
+ */
+static void _JMEST7735RSim_writeByte(JMEST7735RSimPanel_t * panel, uint8_t byte);
+static void _JMEST7735RSim_hardwareReset(JMEST7735RSimPanel_t * panel);
+static void _JMEST7735RSim_command(JMEST7735RSimPanel_t * panel, uint8_t cmd);
+static void _JMEST7735RSim_data(JMEST7735RSimPanel_t * panel, uint8_t data);
+static void _JMEST7735RSim_pixelByte(JMEST7735RSimPanel_t * panel, uint8_t data);
+static void _JMEST7735RSim_storePixel(JMEST7735RSimPanel_t * panel, uint16_t color);
+static uint16_t _JMEST7735RSim_scanLine(const JMEST7735RSimPanel_t * panel, uint16_t y);
+static uint16_t _JMEST7735RSim_shownPixel(const JMEST7735RSimPanel_t * panel, uint16_t x, uint16_t y);
+static void * _JMEST7735RSim_blockWorker(void * argument);
+//
+// adapter entries of a panel
+static void _JMEST7735RSim_select(void * context, BOOL isSelected);
+static void _JMEST7735RSim_writeCommand(void * context, uint8_t cmd);
+static void _JMEST7735RSim_writeBlock(void * context, const uint8_t * data, uint16_t length);
+static void _JMEST7735RSim_fillRepeat(void * context, uint16_t color, uint16_t count);
+static void _JMEST7735RSim_readBlock(void * context, uint8_t * data, uint16_t length);
+static void _JMEST7735RSim_setReset(void * context, BOOL isActive);
+static void _JMEST7735RSim_setBacklight(void * context, BOOL isOn);
+static void _JMEST7735RSim_startBlock(void * context, JMEST7735RDisplay_t * display, const uint8_t * data, uint16_t length);
+static void _JMEST7735RSim_waitBlock(void * context);
+static void _JMEST7735RSim_delayMS(void * context, uint16_t ms);
+
+/*********************************************************************
+ * IMPLEMENT OF PUBLIC FUNCTIONS
+ */
+#pragma mark - bus lines
+void JMEST7735RSim_setReset(BOOL isActive)
+{
+    JMEST7735RSimPanel_setReset(&_panel, isActive);
+}
+
+void JMEST7735RSim_setCD(BOOL isData)
+{
+    JMEST7735RSimPanel_setCD(&_panel, isData);
+}
+
+void JMEST7735RSim_setCS(BOOL isHigh)
+{
+    JMEST7735RSimPanel_setCS(&_panel, isHigh);
+}
+
+void JMEST7735RSim_setBacklight(BOOL isOn)
+{
+    _panel.state.isBacklightOn = isOn;
+}
+
+void JMEST7735RSim_delayMS(uint16_t ms)
+{
+    _panel.stats.delayMS += ms;
+}
+
+void JMEST7735RSim_writeByte(uint8_t byte)
+{
+    _JMEST7735RSim_writeByte(&_panel, byte);
+}
+
+uint8_t JMEST7735RSim_readByte(void)
+{
+    return 0x00;
+}
+
+#pragma mark - block transfer
+void JMEST7735RSim_startBlockWrite(JMEST7735RDisplay_t * display, const uint8_t * data, uint16_t length)
+{
+    JMEST7735RSimPanel_startBlockWrite(&_panel, display, data, length);
+}
+
+void JMEST7735RSim_waitBlockWrite(void)
+{
+    JMEST7735RSimPanel_waitBlockWrite(&_panel);
+}
+
+#pragma mark - inspection
+JMEST7735RSimPanel_t * JMEST7735RSim_panel(void)
+{
+    return &_panel;
+}
+
+void JMEST7735RSim_powerOn(void)
+{
+    JMEST7735RSimPanel_powerOn(&_panel);
+}
+
+void JMEST7735RSim_resetStats(void)
+{
+    JMEST7735RSimPanel_resetStats(&_panel);
+}
+
+void JMEST7735RSim_getStats(JMEST7735RSimStats_t * stats)
+{
+    JMEST7735RSimPanel_getStats(&_panel, stats);
+}
+
+uint16_t JMEST7735RSim_getPixel(uint8_t x, uint8_t y)
+{
+    return JMEST7735RSimPanel_getPixel(&_panel, x, y);
+}
+
+const uint16_t * JMEST7735RSim_framebuffer(void)
+{
+    JMEST7735RSimPanel_waitBlockWrite(&_panel);
+    return _panel.framebuffer;
+}
+
+uint8_t JMEST7735RSim_getMADCTL(void)
+{
+    return _panel.state.madctl;
+}
+
+uint8_t JMEST7735RSim_getCOLMOD(void)
+{
+    return _panel.state.colmod;
+}
+
+BOOL JMEST7735RSim_isSleeping(void)
+{
+    return _panel.state.isSleeping;
+}
+
+BOOL JMEST7735RSim_isDisplayOn(void)
+{
+    return _panel.state.isDisplayOn;
+}
+
+BOOL JMEST7735RSim_dumpPPM(const char * path)
+{
+    return JMEST7735RSimPanel_dumpPPM(&_panel, path);
+}
+
+#pragma mark - panel instances
+void JMEST7735RSimPanel_init(JMEST7735RSimPanel_t * panel, JMEST7735RAdapter_t * adapter)
+{
+    memset(panel, 0, sizeof(*panel));
+    pthread_mutex_init(&panel->block.lock, NULL);
+    pthread_cond_init(&panel->block.changed, NULL);
+    JMEST7735RSimPanel_powerOn(panel);
+    if (NULL != adapter) {
+        adapter->context = panel;
+        adapter->select = _JMEST7735RSim_select;
+        adapter->writeCommand = _JMEST7735RSim_writeCommand;
+        adapter->writeBlock = _JMEST7735RSim_writeBlock;
+        adapter->fillRepeat = _JMEST7735RSim_fillRepeat;
+        adapter->readBlock = _JMEST7735RSim_readBlock;
+        adapter->setReset = _JMEST7735RSim_setReset;
+        adapter->setBacklight = _JMEST7735RSim_setBacklight;
+        adapter->startBlock = _JMEST7735RSim_startBlock;
+        adapter->waitBlock = _JMEST7735RSim_waitBlock;
+        adapter->delayMS = _JMEST7735RSim_delayMS;
+    }
+}
+
+void JMEST7735RSimPanel_setReset(JMEST7735RSimPanel_t * panel, BOOL isActive)
+{
+    if (panel->state.isReset && !isActive) {
+        _JMEST7735RSim_hardwareReset(panel);
+    }
+    panel->state.isReset = isActive;
+}
+
+void JMEST7735RSimPanel_setCD(JMEST7735RSimPanel_t * panel, BOOL isData)
+{
+    isData = isData ? TRUE : FALSE;
+    if (panel->state.isData != isData) {
+        panel->stats.cdSwitches ++;
+        panel->state.isData = isData;
+    }
+}
+
+void JMEST7735RSimPanel_setCS(JMEST7735RSimPanel_t * panel, BOOL isHigh)
+{
+    if (!isHigh && !panel->state.isSelected) {
+        panel->stats.csCycles ++;
+    }
+    panel->state.isSelected = !isHigh;
+}
+
+void JMEST7735RSimPanel_startBlockWrite(JMEST7735RSimPanel_t * panel, JMEST7735RDisplay_t * display,
+                                       const uint8_t * data, uint16_t length)
+{
+    pthread_mutex_lock(&panel->block.lock);
+    if (!panel->block.isStarted) {
+        panel->block.isStarted = 0 == pthread_create(&panel->block.worker, NULL, _JMEST7735RSim_blockWorker, panel);
+    }
+    while (panel->block.isBusy) {
+        pthread_cond_wait(&panel->block.changed, &panel->block.lock);
+    }
+    if (!panel->block.isStarted) {
+        //
+        // no thread available: drain in the caller
+        pthread_mutex_unlock(&panel->block.lock);
+        while (length --) {
+            _JMEST7735RSim_writeByte(panel, *data ++);
+        }
+        if (NULL != display) {
+            JMEST7735RDisplay_blockWriteDone(display);
+        }
+        return;
+    }
+    panel->block.display = display;
+    panel->block.data = data;
+    panel->block.length = length;
+    panel->block.isBusy = TRUE;
+    pthread_cond_broadcast(&panel->block.changed);
+    pthread_mutex_unlock(&panel->block.lock);
+}
+
+void JMEST7735RSimPanel_waitBlockWrite(JMEST7735RSimPanel_t * panel)
+{
+    pthread_mutex_lock(&panel->block.lock);
+    while (panel->block.isBusy) {
+        pthread_cond_wait(&panel->block.changed, &panel->block.lock);
+    }
+    pthread_mutex_unlock(&panel->block.lock);
+}
+
+void JMEST7735RSimPanel_powerOn(JMEST7735RSimPanel_t * panel)
+{
+    JMEST7735RSimPanel_waitBlockWrite(panel);
+    memset(panel->framebuffer, 0, sizeof(panel->framebuffer));
+    memset(&panel->stats, 0, sizeof(panel->stats));
+    panel->state.isData = FALSE;
+    panel->state.isSelected = FALSE;
+    panel->state.isReset = FALSE;
+    panel->state.isBacklightOn = FALSE;
+    _JMEST7735RSim_hardwareReset(panel);
+}
+
+void JMEST7735RSimPanel_resetStats(JMEST7735RSimPanel_t * panel)
+{
+    JMEST7735RSimPanel_waitBlockWrite(panel);
+    memset(&panel->stats, 0, sizeof(panel->stats));
+}
+
+void JMEST7735RSimPanel_getStats(JMEST7735RSimPanel_t * panel, JMEST7735RSimStats_t * stats)
+{
+    JMEST7735RSimPanel_waitBlockWrite(panel);
+    if (NULL != stats) {
+        *stats = panel->stats;
+    }
+}
+
+uint16_t JMEST7735RSimPanel_getPixel(JMEST7735RSimPanel_t * panel, uint8_t x, uint8_t y)
+{
+    JMEST7735RSimPanel_waitBlockWrite(panel);
+    if (x < JMEST7735RSIM_WIDTH && y < JMEST7735RSIM_HEIGHT) {
+        return _JMEST7735RSim_shownPixel(panel, x, y);
+    }
+    return 0;
+}
+
+BOOL JMEST7735RSimPanel_dumpPPM(JMEST7735RSimPanel_t * panel, const char * path)
+{
+    FILE * file;
+    JMEST7735RSimPanel_waitBlockWrite(panel);
+    file = fopen(path, "wb");
+    if (NULL == file) {
+        return FALSE;
+    }
+    fprintf(file, "P6\n%d %d\n255\n", JMEST7735RSIM_WIDTH, JMEST7735RSIM_HEIGHT);
+    for (uint16_t i = 0; i < JMEST7735RSIM_WIDTH * JMEST7735RSIM_HEIGHT; i ++) {
+        uint16_t color = _JMEST7735RSim_shownPixel(panel, i % JMEST7735RSIM_WIDTH, i / JMEST7735RSIM_WIDTH);
+        uint8_t rgb[3];
+        rgb[0] = (uint8_t)(((color >> 11) & 0x1F) * 255 / 31);
+        rgb[1] = (uint8_t)(((color >> 5) & 0x3F) * 255 / 63);
+        rgb[2] = (uint8_t)((color & 0x1F) * 255 / 31);
+        fwrite(rgb, 1, sizeof(rgb), file);
+    }
+    return 0 == fclose(file);
+}
+
+/*********************************************************************
+ * IMPLEMENT OF PRIVATE FUNCTIONS
+ */
+#pragma mark - private functions
+/**
+ *  Worker thread of a panel: clock each queued block onto the bus and report
+ *  it done. The completion handler runs with the engine locked, like an
+ *  interrupt.
+ */
+static void * _JMEST7735RSim_blockWorker(void * argument)
+{
+    JMEST7735RSimPanel_t * panel = (JMEST7735RSimPanel_t *)argument;
+    pthread_mutex_lock(&panel->block.lock);
+    for (;;) {
+        while (!panel->block.isBusy) {
+            pthread_cond_wait(&panel->block.changed, &panel->block.lock);
+        }
+        for (uint16_t i = 0; i < panel->block.length; i ++) {
+            _JMEST7735RSim_writeByte(panel, panel->block.data[i]);
+        }
+        if (NULL != panel->block.display) {
+            JMEST7735RDisplay_blockWriteDone(panel->block.display);
+        }
+        panel->block.isBusy = FALSE;
+        pthread_cond_broadcast(&panel->block.changed);
+    }
+    return NULL;
+}
+
+/**
+ *  One byte on the bus with the current CD and CS levels.
+ */
+static void _JMEST7735RSim_writeByte(JMEST7735RSimPanel_t * panel, uint8_t byte)
+{
+    if (!panel->state.isSelected || panel->state.isReset) {
+        panel->stats.strayBytes ++;
+        return;
+    }
+    panel->stats.bytes ++;
+    if (panel->state.isData) {
+        panel->stats.dataBytes ++;
+        _JMEST7735RSim_data(panel, byte);
+    } else {
+        panel->stats.commands ++;
+        _JMEST7735RSim_command(panel, byte);
+    }
+}
+
+static void _JMEST7735RSim_hardwareReset(JMEST7735RSimPanel_t * panel)
+{
+    panel->state.isSleeping = TRUE;
+    panel->state.isDisplayOn = FALSE;
+    panel->state.madctl = 0x00;
+    panel->state.colmod = 0x06;
+    panel->state.command = JMEST7735RSIM_NOP;
+    panel->state.paramIndex = 0;
+    panel->state.xs = 0; panel->state.xe = JMEST7735RSIM_WIDTH - 1;
+    panel->state.ys = 0; panel->state.ye = JMEST7735RSIM_HEIGHT - 1;
+    panel->state.col = 0; panel->state.row = 0;
+    panel->state.pendingCount = 0;
+    panel->state.tfa = 0; panel->state.vsa = JMEST7735RSIM_HEIGHT; panel->state.bfa = 0;
+    panel->state.ssa = 0;
+    panel->state.isPartial = FALSE;
+    panel->state.isIdle = FALSE;
+    panel->state.psl = 0; panel->state.pel = JMEST7735RSIM_HEIGHT - 1;
+}
+
+static void _JMEST7735RSim_command(JMEST7735RSimPanel_t * panel, uint8_t cmd)
+{
+    panel->state.command = cmd;
+    panel->state.paramIndex = 0;
+    panel->state.pendingCount = 0;
+    switch (cmd) {
+        case JMEST7735RSIM_SWRESET:
+            _JMEST7735RSim_hardwareReset(panel);
+            break;
+        case JMEST7735RSIM_SLPIN:
+            panel->state.isSleeping = TRUE;
+            break;
+        case JMEST7735RSIM_SLPOUT:
+            panel->state.isSleeping = FALSE;
+            break;
+        case JMEST7735RSIM_PTLON:
+            panel->state.isPartial = TRUE;
+            break;
+        case JMEST7735RSIM_NORON:
+            panel->state.isPartial = FALSE;
+            break;
+        case JMEST7735RSIM_IDMOFF:
+            panel->state.isIdle = FALSE;
+            break;
+        case JMEST7735RSIM_IDMON:
+            panel->state.isIdle = TRUE;
+            break;
+        case JMEST7735RSIM_DISPOFF:
+            panel->state.isDisplayOn = FALSE;
+            break;
+        case JMEST7735RSIM_DISPON:
+            panel->state.isDisplayOn = TRUE;
+            break;
+        case JMEST7735RSIM_CASET:
+        case JMEST7735RSIM_RASET:
+            panel->stats.windowSets ++;
+            break;
+        case JMEST7735RSIM_RAMWR:
+            panel->stats.memoryWrites ++;
+            panel->state.col = panel->state.xs;
+            panel->state.row = panel->state.ys;
+            break;
+        default:
+            break;
+    }
+}
+
+static void _JMEST7735RSim_data(JMEST7735RSimPanel_t * panel, uint8_t data)
+{
+    if (JMEST7735RSIM_RAMWR == panel->state.command) {
+        _JMEST7735RSim_pixelByte(panel, data);
+        return;
+    }
+    if (panel->state.paramIndex < sizeof(panel->state.params)) {
+        panel->state.params[panel->state.paramIndex] = data;
+    }
+    panel->state.paramIndex ++;
+    switch (panel->state.command) {
+        case JMEST7735RSIM_CASET:
+            if (4 == panel->state.paramIndex) {
+                panel->state.xs = (panel->state.params[0] << 8) | panel->state.params[1];
+                panel->state.xe = (panel->state.params[2] << 8) | panel->state.params[3];
+            }
+            break;
+        case JMEST7735RSIM_RASET:
+            if (4 == panel->state.paramIndex) {
+                panel->state.ys = (panel->state.params[0] << 8) | panel->state.params[1];
+                panel->state.ye = (panel->state.params[2] << 8) | panel->state.params[3];
+            }
+            break;
+        case JMEST7735RSIM_PTLAR:
+            if (4 == panel->state.paramIndex) {
+                panel->state.psl = (panel->state.params[0] << 8) | panel->state.params[1];
+                panel->state.pel = (panel->state.params[2] << 8) | panel->state.params[3];
+            }
+            break;
+        case JMEST7735RSIM_VSCRDEF:
+            if (6 == panel->state.paramIndex) {
+                panel->state.tfa = (panel->state.params[0] << 8) | panel->state.params[1];
+                panel->state.vsa = (panel->state.params[2] << 8) | panel->state.params[3];
+                panel->state.bfa = (panel->state.params[4] << 8) | panel->state.params[5];
+            }
+            break;
+        case JMEST7735RSIM_VSCSAD:
+            if (2 == panel->state.paramIndex) {
+                panel->state.ssa = (panel->state.params[0] << 8) | panel->state.params[1];
+            }
+            break;
+        case JMEST7735RSIM_MADCTL:
+            if (1 == panel->state.paramIndex) {
+                panel->state.madctl = data;
+            }
+            break;
+        case JMEST7735RSIM_COLMOD:
+            if (1 == panel->state.paramIndex) {
+                panel->state.colmod = data;
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+/**
+ *  Collect the bytes of one transfer unit for the current interface pixel
+ *  format and convert them to RGB565.
+ */
+static void _JMEST7735RSim_pixelByte(JMEST7735RSimPanel_t * panel, uint8_t data)
+{
+    panel->state.pending[panel->state.pendingCount ++] = data;
+    switch (panel->state.colmod & 0x07) {
+        case 0x03:
+            //
+            // 12-bit: RRRRGGGG BBBBRRRR GGGGBBBB carries two pixels, each one
+            // is stored as soon as its 12 bits are in
+            if (2 == panel->state.pendingCount) {
+                uint8_t r0 = panel->state.pending[0] >> 4, g0 = panel->state.pending[0] & 0x0F, b0 = panel->state.pending[1] >> 4;
+                _JMEST7735RSim_storePixel(panel, ((r0 << 1 | r0 >> 3) << 11) | ((g0 << 2 | g0 >> 2) << 5) | (b0 << 1 | b0 >> 3));
+            } else if (3 == panel->state.pendingCount) {
+                uint8_t r1 = panel->state.pending[1] & 0x0F, g1 = panel->state.pending[2] >> 4, b1 = panel->state.pending[2] & 0x0F;
+                _JMEST7735RSim_storePixel(panel, ((r1 << 1 | r1 >> 3) << 11) | ((g1 << 2 | g1 >> 2) << 5) | (b1 << 1 | b1 >> 3));
+                panel->state.pendingCount = 0;
+            }
+            break;
+        case 0x06:
+            //
+            // 18-bit: one byte per component, upper six bits significant
+            if (3 == panel->state.pendingCount) {
+                _JMEST7735RSim_storePixel(panel, ((panel->state.pending[0] >> 3) << 11) |
+                                          ((panel->state.pending[1] >> 2) << 5) |
+                                          (panel->state.pending[2] >> 3));
+                panel->state.pendingCount = 0;
+            }
+            break;
+        default:
+            //
+            // 16-bit: RGB565, high byte first
+            if (2 == panel->state.pendingCount) {
+                _JMEST7735RSim_storePixel(panel, (panel->state.pending[0] << 8) | panel->state.pending[1]);
+                panel->state.pendingCount = 0;
+            }
+            break;
+    }
+}
+
+/**
+ *  Store a pixel at the GRAM write pointer and advance it inside the window.
+ *  The panel is mounted so that MX|MY scans from the top-left corner, which
+ *  is how JMEST7735R_init programs MADCTL, so the framebuffer is kept in
+ *  viewer orientation.
+ */
+static void _JMEST7735RSim_storePixel(JMEST7735RSimPanel_t * panel, uint16_t color)
+{
+    uint16_t x = panel->state.col;
+    uint16_t y = panel->state.row;
+    if (panel->state.madctl & JMEST7735RSIM_MV) {
+        x = panel->state.row;
+        y = panel->state.col;
+    }
+    if (!(panel->state.madctl & JMEST7735RSIM_MX)) {
+        x = JMEST7735RSIM_WIDTH - 1 - x;
+    }
+    if (!(panel->state.madctl & JMEST7735RSIM_MY)) {
+        y = JMEST7735RSIM_HEIGHT - 1 - y;
+    }
+    if (x < JMEST7735RSIM_WIDTH && y < JMEST7735RSIM_HEIGHT) {
+        panel->framebuffer[y * JMEST7735RSIM_WIDTH + x] = color;
+        panel->stats.pixels ++;
+    }
+    if (panel->state.col < panel->state.xe) {
+        panel->state.col ++;
+    } else {
+        panel->state.col = panel->state.xs;
+        panel->state.row = panel->state.row < panel->state.ye ? panel->state.row + 1 : panel->state.ys;
+    }
+}
+
+/**
+ *  Frame memory line shown on screen line `y'. Lines of the scroll area start
+ *  at the start address and wrap at its end; a definition that does not add
+ *  up to the panel height is ignored, as the controller leaves it undefined.
+ */
+static uint16_t _JMEST7735RSim_scanLine(const JMEST7735RSimPanel_t * panel, uint16_t y)
+{
+    uint16_t tfa = panel->state.tfa;
+    uint16_t vsa = panel->state.vsa;
+    if (tfa + vsa + panel->state.bfa != JMEST7735RSIM_HEIGHT || 0 == vsa ||
+        y < tfa || y >= tfa + vsa || panel->state.ssa < tfa || panel->state.ssa >= tfa + vsa) {
+        return y;
+    }
+    return tfa + (y - tfa + panel->state.ssa - tfa) % vsa;
+}
+
+/**
+ *  Pixel on screen at (`x', `y'). Lines outside the partial area show black
+ *  in partial mode; idle mode keeps the top bit of each component.
+ */
+static uint16_t _JMEST7735RSim_shownPixel(const JMEST7735RSimPanel_t * panel, uint16_t x, uint16_t y)
+{
+    uint16_t color;
+    if (panel->state.isPartial && (y < panel->state.psl || y > panel->state.pel)) {
+        return 0x0000;
+    }
+    color = panel->framebuffer[_JMEST7735RSim_scanLine(panel, y) * JMEST7735RSIM_WIDTH + x];
+    if (panel->state.isIdle) {
+        color = ((color & 0x8000) ? 0xF800 : 0) | ((color & 0x0400) ? 0x07E0 : 0) | ((color & 0x0010) ? 0x001F : 0);
+    }
+    return color;
+}
+
+#pragma mark - panel adapter
+static void _JMEST7735RSim_select(void * context, BOOL isSelected)
+{
+    JMEST7735RSimPanel_setCS((JMEST7735RSimPanel_t *)context, !isSelected);
+}
+
+static void _JMEST7735RSim_writeCommand(void * context, uint8_t cmd)
+{
+    JMEST7735RSimPanel_t * panel = (JMEST7735RSimPanel_t *)context;
+    JMEST7735RSimPanel_setCD(panel, FALSE);
+    _JMEST7735RSim_writeByte(panel, cmd);
+}
+
+static void _JMEST7735RSim_writeBlock(void * context, const uint8_t * data, uint16_t length)
+{
+    JMEST7735RSimPanel_t * panel = (JMEST7735RSimPanel_t *)context;
+    JMEST7735RSimPanel_setCD(panel, TRUE);
+    while (length --) {
+        _JMEST7735RSim_writeByte(panel, *data ++);
+    }
+}
+
+static void _JMEST7735RSim_fillRepeat(void * context, uint16_t color, uint16_t count)
+{
+    JMEST7735RSimPanel_t * panel = (JMEST7735RSimPanel_t *)context;
+    JMEST7735RSimPanel_setCD(panel, TRUE);
+    while (count --) {
+        _JMEST7735RSim_writeByte(panel, (uint8_t)(color >> 8));
+        _JMEST7735RSim_writeByte(panel, (uint8_t)color);
+    }
+}
+
+static void _JMEST7735RSim_readBlock(void * context, uint8_t * data, uint16_t length)
+{
+    JMEST7735RSimPanel_setCD((JMEST7735RSimPanel_t *)context, TRUE);
+    memset(data, 0, length);
+}
+
+static void _JMEST7735RSim_setReset(void * context, BOOL isActive)
+{
+    JMEST7735RSimPanel_setReset((JMEST7735RSimPanel_t *)context, isActive);
+}
+
+static void _JMEST7735RSim_setBacklight(void * context, BOOL isOn)
+{
+    ((JMEST7735RSimPanel_t *)context)->state.isBacklightOn = isOn;
+}
+
+static void _JMEST7735RSim_startBlock(void * context, JMEST7735RDisplay_t * display, const uint8_t * data, uint16_t length)
+{
+    JMEST7735RSimPanel_t * panel = (JMEST7735RSimPanel_t *)context;
+    JMEST7735RSimPanel_setCD(panel, TRUE);
+    JMEST7735RSimPanel_startBlockWrite(panel, display, data, length);
+}
+
+static void _JMEST7735RSim_waitBlock(void * context)
+{
+    JMEST7735RSimPanel_waitBlockWrite((JMEST7735RSimPanel_t *)context);
+}
+
+static void _JMEST7735RSim_delayMS(void * context, uint16_t ms)
+{
+    ((JMEST7735RSimPanel_t *)context)->stats.delayMS += ms;
+}
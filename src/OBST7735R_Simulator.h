@@ -0,0 +1,146 @@
+/**
+ Filename:       OBST7735R_Simulator.h
+ Revised:        $Date: 2015-06-18$
+ Revision:       $Revision: 01 $
+
+ Description:    This file contains a software model of the ST7735R controller
+                 for host builds. Define JMEST7735R_HOST_SIM and the adapter
+                 routes every bus access of the driver into this model.
+
+ Copyright 2015 ObornJung. All rights reserved.
+ */
+
+#ifndef __H__JMEST7735R_Simulator__H__
+#define __H__JMEST7735R_Simulator__H__
+
+/*********************************************************************
+ * INCLUDES
+ */
+#include <pthread.h>
+#include "JMEBase.h"
+#include "OBST7735R_DriveLib.h"
+
+/*********************************************************************
+ * MACROS
+ */
+#define JMEST7735RSIM_WIDTH             128
+#define JMEST7735RSIM_HEIGHT            160
+
+/*********************************************************************
+ * TYPEDEFS
+ */
+/**
+ *  Bus cycle counters, accumulated since the last JMEST7735RSim_resetStats().
+ */
+typedef struct {
+    uint32_t            bytes;              ///< bytes latched by the controller
+    uint32_t            commands;           ///< command bytes (CD low)
+    uint32_t            dataBytes;          ///< parameter and pixel bytes (CD high)
+    uint32_t            cdSwitches;         ///< transitions of the command/data line
+    uint32_t            csCycles;           ///< chip select assertions
+    uint32_t            windowSets;         ///< CASET and RASET commands
+    uint32_t            memoryWrites;       ///< RAMWR commands
+    uint32_t            pixels;             ///< pixels stored into GRAM
+    uint32_t            strayBytes;         ///< bytes written while CS was high
+    uint32_t            delayMS;            ///< total time spent in JMEST7735R_delayMS
+}JMEST7735RSimStats_t;
+
+/**
+ *  Controller registers and bus line levels of one panel.
+ */
+typedef struct {
+    BOOL                isReset;            ///< reset line held active
+    BOOL                isData;             ///< CD line level
+    BOOL                isSelected;         ///< CS line low
+    BOOL                isBacklightOn;
+    BOOL                isSleeping;
+    BOOL                isDisplayOn;
+    BOOL                isPartial;          ///< only the partial area is scanned
+    BOOL                isIdle;             ///< 8 colors
+    uint8_t             madctl;
+    uint8_t             colmod;
+    uint8_t             command;            ///< last command byte
+    uint8_t             paramIndex;         ///< parameter bytes received for `command'
+    uint8_t             params[6];
+    uint16_t            xs, xe, ys, ye;     ///< address window
+    uint16_t            col, row;           ///< GRAM write pointer
+    uint8_t             pending[3];         ///< partial pixel bytes of the current format
+    uint8_t             pendingCount;
+    uint16_t            tfa, vsa, bfa;      ///< vertical scrolling definition
+    uint16_t            ssa;                ///< frame memory line shown at the top of the scroll area
+    uint16_t            psl, pel;           ///< partial area, first and last line
+}JMEST7735RSimState_t;
+
+/**
+ *  Block transfer engine, standing in for the DMA channel of the target.
+ */
+typedef struct {
+    pthread_mutex_t     lock;
+    pthread_cond_t      changed;
+    pthread_t           worker;
+    BOOL                isStarted;          ///< worker thread created
+    BOOL                isBusy;             ///< a block is queued or on the wire
+    JMEST7735RDisplay_t * display;          ///< told when the block is out
+    const uint8_t       * data;
+    uint16_t            length;
+}JMEST7735RSimBlock_t;
+
+/**
+ *  One simulated panel with its own bus, so several can be driven at once.
+ */
+typedef struct {
+    JMEST7735RSimState_t state;
+    JMEST7735RSimStats_t stats;
+    JMEST7735RSimBlock_t block;
+    uint16_t            framebuffer[JMEST7735RSIM_WIDTH * JMEST7735RSIM_HEIGHT];  ///< frame memory, viewer orientation before scrolling
+}JMEST7735RSimPanel_t;
+
+/*********************************************************************
+ * FUNCTIONS
+ */
+//
+// bus lines, driven by OBST7735R_Adapter.h
+JME_EXTERN void JMEST7735RSim_setReset(BOOL isActive);
+JME_EXTERN void JMEST7735RSim_setCD(BOOL isData);
+JME_EXTERN void JMEST7735RSim_setCS(BOOL isHigh);
+JME_EXTERN void JMEST7735RSim_setBacklight(BOOL isOn);
+JME_EXTERN void JMEST7735RSim_delayMS(uint16_t ms);
+JME_EXTERN void JMEST7735RSim_writeByte(uint8_t byte);
+JME_EXTERN uint8_t JMEST7735RSim_readByte(void);
+//
+// block transfer: a worker thread writes `length' bytes with the current CD
+// and CS levels, then calls JMEST7735RDisplay_blockWriteDone(display).
+// Inspection waits for the transfer.
+JME_EXTERN void JMEST7735RSim_startBlockWrite(JMEST7735RDisplay_t * display, const uint8_t * data, uint16_t length);
+JME_EXTERN void JMEST7735RSim_waitBlockWrite(void);
+//
+// inspection
+JME_EXTERN JMEST7735RSimPanel_t * JMEST7735RSim_panel(void);
+JME_EXTERN void JMEST7735RSim_powerOn(void);
+JME_EXTERN void JMEST7735RSim_resetStats(void);
+JME_EXTERN void JMEST7735RSim_getStats(JMEST7735RSimStats_t * stats);
+JME_EXTERN uint16_t JMEST7735RSim_getPixel(uint8_t x, uint8_t y);         ///< as seen: scrolled, partial and idle mode applied
+JME_EXTERN const uint16_t * JMEST7735RSim_framebuffer(void);
+JME_EXTERN uint8_t JMEST7735RSim_getMADCTL(void);
+JME_EXTERN uint8_t JMEST7735RSim_getCOLMOD(void);
+JME_EXTERN BOOL JMEST7735RSim_isSleeping(void);
+JME_EXTERN BOOL JMEST7735RSim_isDisplayOn(void);
+JME_EXTERN BOOL JMEST7735RSim_dumpPPM(const char * path);
+//
+// panel instances. JMEST7735RSimPanel_init powers the panel on and fills
+// `adapter' with entry points bound to it, for JMEST7735RDisplay_create.
+// The functions above act on the panel returned by JMEST7735RSim_panel().
+JME_EXTERN void JMEST7735RSimPanel_init(JMEST7735RSimPanel_t * panel, JMEST7735RAdapter_t * adapter);
+JME_EXTERN void JMEST7735RSimPanel_setReset(JMEST7735RSimPanel_t * panel, BOOL isActive);
+JME_EXTERN void JMEST7735RSimPanel_setCD(JMEST7735RSimPanel_t * panel, BOOL isData);
+JME_EXTERN void JMEST7735RSimPanel_setCS(JMEST7735RSimPanel_t * panel, BOOL isHigh);
+JME_EXTERN void JMEST7735RSimPanel_startBlockWrite(JMEST7735RSimPanel_t * panel, JMEST7735RDisplay_t * display,
+                                                   const uint8_t * data, uint16_t length);
+JME_EXTERN void JMEST7735RSimPanel_waitBlockWrite(JMEST7735RSimPanel_t * panel);
+JME_EXTERN void JMEST7735RSimPanel_powerOn(JMEST7735RSimPanel_t * panel);
+JME_EXTERN void JMEST7735RSimPanel_resetStats(JMEST7735RSimPanel_t * panel);
+JME_EXTERN void JMEST7735RSimPanel_getStats(JMEST7735RSimPanel_t * panel, JMEST7735RSimStats_t * stats);
+JME_EXTERN uint16_t JMEST7735RSimPanel_getPixel(JMEST7735RSimPanel_t * panel, uint8_t x, uint8_t y);
+JME_EXTERN BOOL JMEST7735RSimPanel_dumpPPM(JMEST7735RSimPanel_t * panel, const char * path);
+
+#endif /* defined(__H__JMEST7735R_Simulator__H__) */